@@ -1,10 +1,16 @@
+#include <kitgenbench/CoSchedule.h>
 #include <kitgenbench/DeviceClock.h>
+#include <kitgenbench/HandoffQueue.h>
+#include <kitgenbench/SizeList.h>
 #include <kitgenbench/kitgenbench.h>
+#include <kitgenbench/overlap.h>
 #include <kitgenbench/setup.h>
 #include <kitgenbench/version.h>
+#include <sys/mman.h>
 
 #include <alpaka/workdiv/WorkDivMembers.hpp>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <tuple>
 #include <utility>
@@ -36,13 +42,31 @@ using Acc = alpaka::TagToAcc<AccTag, Dim, Idx>;
 namespace kitgenbench::Actions {
   [[maybe_unused]] static constexpr int MALLOC = 1;
   [[maybe_unused]] static constexpr int FREE = 2;
+  // Freeing memory that was allocated by another thread.
+  [[maybe_unused]] static constexpr int REMOTE_FREE = 3;
+  // Passing memory on to or receiving it from another thread.
+  [[maybe_unused]] static constexpr int HANDOFF = 4;
+  // Telling the system how memory that was just allocated is going to be used.
+  [[maybe_unused]] static constexpr int ADVISE = 5;
 }  // namespace kitgenbench::Actions
 
+// Size of the heap the allocator is working on. On the GPU, this is what we set as
+// `cudaLimitMallocHeapSize`. The host heap has no such limit, so we make up a nominal capacity that
+// setups like the heap ramp can measure their fill level against. The allocator never fails there
+// when the nominal capacity is reached.
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+static constexpr unsigned long long HEAP_SIZE = 1024U * 1024U * 1024U;
+static constexpr bool HEAP_IS_BOUNDED = true;
+#else
+static constexpr unsigned long long HEAP_SIZE = 16U * 1024U * 1024U;
+static constexpr bool HEAP_IS_BOUNDED = false;
+#endif  // ALPAKA_ACC_GPU_CUDA_ENABLED
+
 auto makeExecutionDetails() {
   auto const platformAcc = alpaka::Platform<Acc>{};
   auto const dev = alpaka::getDevByIdx(platformAcc, 0);
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
-  cudaDeviceSetLimit(cudaLimitMallocHeapSize, 1024U * 1024U * 1024U);
+  cudaDeviceSetLimit(cudaLimitMallocHeapSize, HEAP_SIZE);
 #endif
   uint32_t const numThreadsPerBlock = 256U;
   uint32_t const numThreads = 4U * numThreadsPerBlock;
@@ -54,17 +78,131 @@ auto makeExecutionDetails() {
           {numThreads / numThreadsPerBlock}, {numThreadsPerBlock}, {1U}};
     }
   }();
-  return kitgenbench::ExecutionDetails<Acc, decltype(dev)>{workdiv, dev};
+  // Reports an error instead of energies where RAPL is not available.
+  return kitgenbench::ExecutionDetails<Acc, decltype(dev)>{workdiv, dev, {}, EnergyProbe{}};
+}
+
+// Number of device clock ticks per millisecond.
+auto getClockRate() {
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+  cudaDeviceProp prop;
+  cudaGetDeviceProperties(&prop, 0);
+  return prop.clockRate;
+#else
+  return 1;
+#endif  // ALPAKA_ACC_GPU_CUDA_ENABLED
 }
 
 static constexpr std::uint32_t ALLOCATION_SIZE = 16U;
+// The smallest page size in common use. Touching every this many bytes touches every page.
+static constexpr std::size_t BASE_PAGE_SIZE{4096U};
+// Allocation sizes that get their own fixed-extent code paths. All others use a dynamic extent.
+using AllocationSizes = PowersOfTwo<8U, 64U * 1024U>;
 
 // Reasons for the check to yield the result it yielded.
 // `completed` means that the check completed. The result can still be true/false depending on
 // whether the obtained value was actually correct. `notApplicable` means that the checks were
 // skipped. `nullpointer` means that a nullpointer was given, so the checks couldn't run at all.
-enum class Reason { completed, notApplicable, nullpointer };
-using Payload = std::variant<std::span<std::byte, ALLOCATION_SIZE>, std::pair<bool, Reason>>;
+// `deferred` means that the data was recorded to be checked after the run.
+enum class Reason { completed, notApplicable, nullpointer, deferred };
+using Range = AllocationSizes::Spans<std::byte>;
+
+// What `realloc` did: `range` is the memory obtained and `previous` the address where the data was
+// before, so in-place and moving reallocations can be told apart. It's only an address because the
+// memory there might have been freed.
+struct Reallocation {
+  std::span<std::byte> range{};
+  std::uintptr_t previous{0U};
+  std::size_t previousSize{0U};
+};
+
+// Memory obtained from `aligned_alloc` together with the alignment that was asked for.
+struct AlignedRange {
+  std::span<std::byte> range{};
+  std::size_t alignment{0U};
+};
+
+using Payload = std::variant<Range, std::pair<bool, Reason>, Reallocation, AlignedRange>;
+
+// Runs `func` when going out of scope. Returning the result that describes a deallocation from the
+// scope of a guard freeing the memory builds the result in place before the memory is freed. So,
+// the freed pointer isn't even copied afterwards.
+template <typename TFunc> struct OnReturn {
+  TFunc func;
+  ALPAKA_FN_ACC ~OnReturn() { func(); }
+};
+
+// Device code only has `malloc` and `free`. The other allocation functions are emulated on top of
+// them there, just like a user of the device-side allocator would have to.
+namespace allocation {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+  ALPAKA_FN_ACC inline void* callocate(std::size_t const size) {
+    auto* pointer = malloc(size);
+    if (pointer != nullptr) {
+      memset(pointer, 0, size);
+    }
+    return pointer;
+  }
+
+  ALPAKA_FN_ACC inline void* reallocate(void* pointer, std::size_t const oldSize,
+                                        std::size_t const newSize) {
+    auto* result = malloc(newSize);
+    if (result != nullptr and pointer != nullptr) {
+      memcpy(result, pointer, oldSize < newSize ? oldSize : newSize);
+      free(pointer);
+    }
+    return result;
+  }
+
+  // The pointer obtained from `malloc` is stored right in front of the aligned memory.
+  ALPAKA_FN_ACC inline void* alignedAllocate(std::size_t const alignment, std::size_t const size) {
+    auto* raw = static_cast<std::byte*>(malloc(size + alignment + sizeof(void*)));
+    if (raw == nullptr) {
+      return nullptr;
+    }
+    auto const address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+    auto* aligned = raw + sizeof(void*) + (alignment - address % alignment) % alignment;
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return aligned;
+  }
+
+  ALPAKA_FN_ACC inline void alignedFree(void* pointer) {
+    if (pointer != nullptr) {
+      free(static_cast<void**>(pointer)[-1]);
+    }
+  }
+
+  // There are no transparent huge pages to ask for on the device.
+  ALPAKA_FN_ACC inline void adviseHugePages(void*, std::size_t const, bool const) {}
+#else
+  ALPAKA_FN_ACC inline void* callocate(std::size_t const size) { return std::calloc(1U, size); }
+
+  ALPAKA_FN_ACC inline void* reallocate(void* pointer, [[maybe_unused]] std::size_t const oldSize,
+                                        std::size_t const newSize) {
+    return std::realloc(pointer, newSize);
+  }
+
+  // `aligned_alloc` wants the size to be a multiple of the alignment.
+  ALPAKA_FN_ACC inline void* alignedAllocate(std::size_t const alignment, std::size_t const size) {
+    return std::aligned_alloc(alignment, (size + alignment - 1U) / alignment * alignment);
+  }
+
+  ALPAKA_FN_ACC inline void alignedFree(void* pointer) { std::free(pointer); }
+
+  // `madvise` only works on whole pages, so the hint is restricted to the pages fully inside the
+  // range.
+  ALPAKA_FN_ACC inline void adviseHugePages(void* pointer, std::size_t const size,
+                                            bool const huge) {
+    auto const begin = (reinterpret_cast<std::uintptr_t>(pointer) + BASE_PAGE_SIZE - 1U)
+                       / BASE_PAGE_SIZE * BASE_PAGE_SIZE;
+    auto const end = (reinterpret_cast<std::uintptr_t>(pointer) + size) / BASE_PAGE_SIZE
+                     * BASE_PAGE_SIZE;
+    if (pointer != nullptr and begin < end) {
+      madvise(reinterpret_cast<void*>(begin), end - begin, huge ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+    }
+  }
+#endif
+}  // namespace allocation
 
 template <typename TAccTag> struct SimpleSumLogger {
   using Clock = DeviceClock<TAccTag>;
@@ -75,6 +213,19 @@ template <typename TAccTag> struct SimpleSumLogger {
   DeviceClock<TAccTag>::DurationType freeDuration;
   std::uint32_t freeCounter{0U};
 
+  DeviceClock<TAccTag>::DurationType remoteFreeDuration;
+  std::uint32_t remoteFreeCounter{0U};
+
+  DeviceClock<TAccTag>::DurationType reallocDuration;
+  std::uint32_t reallocCounter{0U};
+  std::uint32_t inPlaceReallocCounter{0U};
+
+  DeviceClock<TAccTag>::DurationType callocDuration;
+  std::uint32_t callocCounter{0U};
+
+  DeviceClock<TAccTag>::DurationType alignedAllocDuration;
+  std::uint32_t alignedAllocCounter{0U};
+
   std::uint32_t nullpointersObtained{0U};
   std::uint32_t failedChecksCounter{0U};
   std::uint32_t invalidCheckResults{0U};
@@ -96,6 +247,31 @@ template <typename TAccTag> struct SimpleSumLogger {
       freeCounter++;
     }
 
+    if (std::get<0>(result) == Actions::REMOTE_FREE) {
+      remoteFreeDuration += Clock::duration(start, end);
+      remoteFreeCounter++;
+    }
+
+    if (std::get<0>(result) == Actions::REALLOC) {
+      reallocDuration += Clock::duration(start, end);
+      reallocCounter++;
+      auto const& reallocation = std::get<Reallocation>(std::get<1>(result));
+      auto const obtained = reinterpret_cast<std::uintptr_t>(reallocation.range.data());
+      if (obtained != 0U and obtained == reallocation.previous) {
+        inPlaceReallocCounter++;
+      }
+    }
+
+    if (std::get<0>(result) == Actions::CALLOC) {
+      callocDuration += Clock::duration(start, end);
+      callocCounter++;
+    }
+
+    if (std::get<0>(result) == Actions::ALIGNED_ALLOC) {
+      alignedAllocDuration += Clock::duration(start, end);
+      alignedAllocCounter++;
+    }
+
     if (std::get<0>(result) == Actions::CHECK) {
       if (std::holds_alternative<std::pair<bool, Reason>>(std::get<1>(result))) {
         auto [passed, reason] = std::get<std::pair<bool, Reason>>(std::get<1>(result));
@@ -120,19 +296,22 @@ template <typename TAccTag> struct SimpleSumLogger {
     alpaka::atomicAdd(acc, &mallocCounter, other.mallocCounter);
     alpaka::atomicAdd(acc, &freeDuration, other.freeDuration);
     alpaka::atomicAdd(acc, &freeCounter, other.freeCounter);
+    alpaka::atomicAdd(acc, &remoteFreeDuration, other.remoteFreeDuration);
+    alpaka::atomicAdd(acc, &remoteFreeCounter, other.remoteFreeCounter);
+    alpaka::atomicAdd(acc, &reallocDuration, other.reallocDuration);
+    alpaka::atomicAdd(acc, &reallocCounter, other.reallocCounter);
+    alpaka::atomicAdd(acc, &inPlaceReallocCounter, other.inPlaceReallocCounter);
+    alpaka::atomicAdd(acc, &callocDuration, other.callocDuration);
+    alpaka::atomicAdd(acc, &callocCounter, other.callocCounter);
+    alpaka::atomicAdd(acc, &alignedAllocDuration, other.alignedAllocDuration);
+    alpaka::atomicAdd(acc, &alignedAllocCounter, other.alignedAllocCounter);
     alpaka::atomicAdd(acc, &nullpointersObtained, other.nullpointersObtained);
     alpaka::atomicAdd(acc, &failedChecksCounter, other.failedChecksCounter);
     alpaka::atomicAdd(acc, &invalidCheckResults, other.invalidCheckResults);
   }
 
   nlohmann::json generateReport() {
-#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
-    cudaDeviceProp prop;
-    cudaGetDeviceProperties(&prop, 0);
-    auto clockRate = prop.clockRate;
-#else
-    auto clockRate = 1;
-#endif  // ALPAKA_ACC_GPU_CUDA_ENABLED
+    auto clockRate = getClockRate();
     return {
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
         {"clock rate [1/ms]", clockRate},
@@ -144,7 +323,26 @@ template <typename TAccTag> struct SimpleSumLogger {
         {"deallocation total time [ms]", freeDuration / clockRate},
         {"deallocation average time [ms]",
          freeDuration / clockRate / (freeCounter > 0 ? freeCounter : 1U)},
-        {"deallocation count ", freeCounter},
+        {"deallocation count", freeCounter},
+        {"remote deallocation total time [ms]", remoteFreeDuration / clockRate},
+        {"remote deallocation average time [ms]",
+         remoteFreeDuration / clockRate / (remoteFreeCounter > 0 ? remoteFreeCounter : 1U)},
+        {"remote deallocation count", remoteFreeCounter},
+        {"reallocation total time [ms]", reallocDuration / clockRate},
+        {"reallocation average time [ms]",
+         reallocDuration / clockRate / (reallocCounter > 0 ? reallocCounter : 1U)},
+        {"reallocation count", reallocCounter},
+        {"in-place reallocation count", inPlaceReallocCounter},
+        {"in-place reallocation rate",
+         static_cast<double>(inPlaceReallocCounter) / (reallocCounter > 0 ? reallocCounter : 1U)},
+        {"zeroed allocation total time [ms]", callocDuration / clockRate},
+        {"zeroed allocation average time [ms]",
+         callocDuration / clockRate / (callocCounter > 0 ? callocCounter : 1U)},
+        {"zeroed allocation count", callocCounter},
+        {"aligned allocation total time [ms]", alignedAllocDuration / clockRate},
+        {"aligned allocation average time [ms]",
+         alignedAllocDuration / clockRate / (alignedAllocCounter > 0 ? alignedAllocCounter : 1U)},
+        {"aligned allocation count", alignedAllocCounter},
         {"failed checks count", failedChecksCounter},
         {"nullpointers count", nullpointersObtained},
         {"invalid check results count", invalidCheckResults},
@@ -152,6 +350,188 @@ template <typename TAccTag> struct SimpleSumLogger {
   }
 };
 
+// Logs allocation latency bucketed by how full the heap was when the allocation was requested.
+// The fill level is tracked in a counter shared by all threads which is updated after every
+// successful allocation and every deallocation, so it's only exact if every byte passing through
+// the allocator is logged by an instance of this logger.
+template <typename TAccTag> struct HeapFillLogger {
+  using Clock = DeviceClock<TAccTag>;
+  // Number of buckets below the nominal heap size. There's one more bucket collecting everything
+  // beyond that.
+  static constexpr std::uint32_t numBuckets{20U};
+  static constexpr unsigned long long noFailure{std::numeric_limits<unsigned long long>::max()};
+
+  unsigned long long* bytesInUse{nullptr};
+  // The fill level at the first failed allocation. It's claimed by whichever thread fails first,
+  // later failures (possibly at a lower fill level) don't change it.
+  unsigned long long* firstFailureBytesInUse{nullptr};
+  unsigned long long heapSize{HEAP_SIZE};
+
+  std::array<typename Clock::DurationType, numBuckets + 1> mallocDuration{};
+  std::array<std::uint32_t, numBuckets + 1> mallocCounter{};
+
+  DeviceClock<TAccTag>::DurationType failedMallocDuration{};
+  std::uint32_t failedMallocCounter{0U};
+
+  DeviceClock<TAccTag>::DurationType freeDuration{};
+  std::uint32_t freeCounter{0U};
+
+  ALPAKA_FN_INLINE ALPAKA_FN_ACC auto bucketOf(unsigned long long const bytes) const {
+    return static_cast<std::uint32_t>(std::min(bytes * numBuckets / heapSize,
+                                               static_cast<unsigned long long>(numBuckets)));
+  }
+
+  template <typename TAcc> ALPAKA_FN_INLINE ALPAKA_FN_ACC auto call(TAcc const& acc, auto func) {
+    static_assert(
+        std::is_same_v<alpaka::TagToAcc<TAccTag, alpaka::Dim<Acc>, alpaka::Idx<Acc>>, TAcc>);
+    auto start = Clock::clock();
+    auto result = func(acc);
+    auto end = Clock::clock();
+
+    if (std::get<0>(result) == Actions::MALLOC) {
+      auto range = asDynamicSpan(std::get<0>(std::get<1>(result)));
+      if (range.data() == nullptr) {
+        failedMallocDuration += Clock::duration(start, end);
+        failedMallocCounter++;
+        alpaka::atomicCas(acc, firstFailureBytesInUse, noFailure,
+                          alpaka::atomicAdd(acc, bytesInUse, 0ULL));
+      } else {
+        // The counter is updated after the fact, so we bucket by the fill level the allocator saw.
+        auto const bucket = bucketOf(
+            alpaka::atomicAdd(acc, bytesInUse, static_cast<unsigned long long>(range.size())));
+        mallocDuration[bucket] += Clock::duration(start, end);
+        mallocCounter[bucket]++;
+      }
+    }
+
+    if (std::get<0>(result) == Actions::FREE) {
+      alpaka::atomicSub(
+          acc, bytesInUse,
+          static_cast<unsigned long long>(asDynamicSpan(std::get<0>(std::get<1>(result))).size()));
+      freeDuration += Clock::duration(start, end);
+      freeCounter++;
+    }
+
+    return result;
+  }
+
+  ALPAKA_FN_ACC void accumulate(const auto& acc, const HeapFillLogger& other) {
+    for (std::uint32_t i = 0U; i < numBuckets + 1; ++i) {
+      alpaka::atomicAdd(acc, &mallocDuration[i], other.mallocDuration[i]);
+      alpaka::atomicAdd(acc, &mallocCounter[i], other.mallocCounter[i]);
+    }
+    alpaka::atomicAdd(acc, &failedMallocDuration, other.failedMallocDuration);
+    alpaka::atomicAdd(acc, &failedMallocCounter, other.failedMallocCounter);
+    alpaka::atomicAdd(acc, &freeDuration, other.freeDuration);
+    alpaka::atomicAdd(acc, &freeCounter, other.freeCounter);
+  }
+
+  nlohmann::json generateReport() {
+    auto clockRate = getClockRate();
+    auto curve = nlohmann::json::array();
+    for (std::uint32_t i = 0U; i < numBuckets + 1; ++i) {
+      curve.push_back(
+          {{"heap fill from [fraction]", static_cast<double>(i) / numBuckets},
+           {"heap fill to [fraction]",
+            i < numBuckets ? nlohmann::json(static_cast<double>(i + 1) / numBuckets)
+                           : nlohmann::json(nullptr)},
+           {"allocation count", mallocCounter[i]},
+           {"allocation average time [ms]",
+            mallocDuration[i] / clockRate / (mallocCounter[i] > 0 ? mallocCounter[i] : 1U)}});
+    }
+    // Like in the other loggers, this includes the failed allocations.
+    std::uint32_t allocations = failedMallocCounter;
+    for (auto const count : mallocCounter) {
+      allocations += count;
+    }
+    return {
+        {"heap size [bytes]", heapSize},
+        {"allocation count", allocations},
+        {"failed allocation count", failedMallocCounter},
+        {"failed allocation average time [ms]",
+         failedMallocDuration / clockRate / (failedMallocCounter > 0 ? failedMallocCounter : 1U)},
+        {"deallocation count", freeCounter},
+        {"deallocation average time [ms]",
+         freeDuration / clockRate / (freeCounter > 0 ? freeCounter : 1U)},
+        {"latency by heap fill", curve},
+    };
+  }
+};
+
+// Logs the time it takes to touch fresh memory for the first time separately from the time it took
+// to allocate it. The touching is done by the `FirstTouchChecker`, so any completed check counts as
+// a first touch of the latest allocation. Giving advice is not timed at all.
+template <typename TAccTag> struct FirstTouchLogger {
+  using Clock = DeviceClock<TAccTag>;
+
+  DeviceClock<TAccTag>::DurationType mallocDuration{};
+  std::uint32_t mallocCounter{0U};
+
+  DeviceClock<TAccTag>::DurationType touchDuration{};
+  unsigned long long touchedPages{0U};
+  std::size_t latestAllocationSize{0U};
+
+  DeviceClock<TAccTag>::DurationType freeDuration{};
+  std::uint32_t freeCounter{0U};
+
+  template <typename TAcc> ALPAKA_FN_INLINE ALPAKA_FN_ACC auto call(TAcc const& acc, auto func) {
+    static_assert(
+        std::is_same_v<alpaka::TagToAcc<TAccTag, alpaka::Dim<Acc>, alpaka::Idx<Acc>>, TAcc>);
+    auto start = Clock::clock();
+    auto result = func(acc);
+    auto end = Clock::clock();
+
+    if (std::get<0>(result) == Actions::MALLOC) {
+      mallocDuration += Clock::duration(start, end);
+      mallocCounter++;
+      latestAllocationSize = asDynamicSpan(std::get<Range>(std::get<1>(result))).size();
+    }
+
+    if (std::get<0>(result) == Actions::CHECK
+        and std::holds_alternative<std::pair<bool, Reason>>(std::get<1>(result))
+        and std::get<std::pair<bool, Reason>>(std::get<1>(result)).second == Reason::completed) {
+      touchDuration += Clock::duration(start, end);
+      touchedPages += (latestAllocationSize + BASE_PAGE_SIZE - 1U) / BASE_PAGE_SIZE;
+    }
+
+    if (std::get<0>(result) == Actions::FREE) {
+      freeDuration += Clock::duration(start, end);
+      freeCounter++;
+    }
+
+    return result;
+  }
+
+  ALPAKA_FN_ACC void accumulate(const auto& acc, const FirstTouchLogger& other) {
+    alpaka::atomicAdd(acc, &mallocDuration, other.mallocDuration);
+    alpaka::atomicAdd(acc, &mallocCounter, other.mallocCounter);
+    alpaka::atomicAdd(acc, &touchDuration, other.touchDuration);
+    alpaka::atomicAdd(acc, &touchedPages, other.touchedPages);
+    alpaka::atomicAdd(acc, &freeDuration, other.freeDuration);
+    alpaka::atomicAdd(acc, &freeCounter, other.freeCounter);
+  }
+
+  nlohmann::json generateReport() {
+    auto clockRate = getClockRate();
+    return {
+        {"allocation average time [ms]",
+         mallocDuration / clockRate / (mallocCounter > 0 ? mallocCounter : 1U)},
+        {"allocation count", mallocCounter},
+        {"first touch total time [ms]", touchDuration / clockRate},
+        {"first touch average time per allocation [ms]",
+         touchDuration / clockRate / (mallocCounter > 0 ? mallocCounter : 1U)},
+        {"first touch average time per page [ms]",
+         static_cast<double>(touchDuration) / clockRate
+             / static_cast<double>(touchedPages > 0 ? touchedPages : 1U)},
+        {"touched pages count", touchedPages},
+        {"page size [bytes]", BASE_PAGE_SIZE},
+        {"deallocation average time [ms]",
+         freeDuration / clockRate / (freeCounter > 0 ? freeCounter : 1U)},
+        {"deallocation count", freeCounter},
+    };
+  }
+};
+
 template <template <typename, size_t> typename T, typename TType, size_t TExtent> struct IsSpan {
   static constexpr bool value = std::is_same_v<T<TType, TExtent>, std::span<TType, TExtent>>;
 };
@@ -163,8 +543,11 @@ constexpr auto isSpan(T<TType, TExtent>) {
 
 template <typename TNew, typename TOld, std::size_t TExtent>
 constexpr auto convertDataType(std::span<TOld, TExtent>& range) {
-  return std::span<TNew, TExtent * sizeof(TOld) / sizeof(TNew)>(
-      reinterpret_cast<TNew*>(range.data()), range.size());
+  constexpr auto newExtent = TExtent == std::dynamic_extent
+                                 ? std::dynamic_extent
+                                 : TExtent * sizeof(TOld) / sizeof(TNew);
+  return std::span<TNew, newExtent>(reinterpret_cast<TNew*>(range.data()),
+                                    range.size() * sizeof(TOld) / sizeof(TNew));
 }
 
 struct IotaReductionChecker {
@@ -174,19 +557,25 @@ struct IotaReductionChecker {
     if (std::get<0>(result) != Actions::MALLOC) {
       return std::make_tuple(Actions::CHECK, Payload(std::make_pair(true, Reason::notApplicable)));
     }
-    auto range = std::get<0>(std::get<1>(result));
-    if (range.data() == nullptr) {
-      return std::make_tuple(Actions::CHECK, Payload(std::make_pair(false, Reason::nullpointer)));
-    }
-    auto uintRange = convertDataType<uint32_t>(range);
-    std::iota(std::begin(uintRange), std::end(uintRange), currentValue);
-    size_t n = uintRange.size();
-    // The exact formula is using size_t because n is size_t. Casting it down will oftentimes run
-    // into an overflow that the reduction encounters, too.
-    auto expected = static_cast<uint32_t>(n * currentValue + n * (n - 1) / 2) ^ currentValue;
-    currentValue ^= std::reduce(std::cbegin(uintRange), std::cend(uintRange));
-    return std::make_tuple(+Actions::CHECK,
-                           Payload(std::make_pair(expected == currentValue, Reason::completed)));
+    // Dispatching on the span's type keeps the extent known at compile time for listed sizes.
+    return visitAlternatives(
+        [this](auto range) {
+          if (range.data() == nullptr) {
+            return std::make_tuple(+Actions::CHECK,
+                                   Payload(std::make_pair(false, Reason::nullpointer)));
+          }
+          auto uintRange = convertDataType<uint32_t>(range);
+          std::iota(std::begin(uintRange), std::end(uintRange), currentValue);
+          size_t n = uintRange.size();
+          // The exact formula is using size_t because n is size_t. Casting it down will oftentimes
+          // run into an overflow that the reduction encounters, too.
+          auto expected = static_cast<uint32_t>(n * currentValue + n * (n - 1) / 2) ^ currentValue;
+          currentValue ^= std::reduce(std::cbegin(uintRange), std::cend(uintRange));
+          return std::make_tuple(
+              +Actions::CHECK,
+              Payload(std::make_pair(expected == currentValue, Reason::completed)));
+        },
+        std::get<0>(std::get<1>(result)));
   }
 
   ALPAKA_FN_ACC auto accumulate(const auto& acc, const auto& other) {
@@ -196,12 +585,132 @@ struct IotaReductionChecker {
   nlohmann::json generateReport() { return {{"final value", currentValue}}; }
 };
 
+// Fills all memory obtained with a pattern and verifies what the allocation functions promise
+// beyond handing out memory: zeros for `calloc`, the previous content for `realloc` and the
+// requested alignment for `aligned_alloc`.
+struct ContentChecker {
+  // The period is prime, so the pattern doesn't repeat in sync with power-of-two sizes.
+  ALPAKA_FN_INLINE ALPAKA_FN_ACC static auto pattern(std::size_t const offset) {
+    return static_cast<std::byte>(offset % 251U);
+  }
+
+  ALPAKA_FN_INLINE ALPAKA_FN_ACC static void fill(std::span<std::byte> range,
+                                                  std::size_t const from = 0U) {
+    for (std::size_t i = from; i < range.size(); ++i) {
+      range[i] = pattern(i);
+    }
+  }
+
+  ALPAKA_FN_ACC auto check([[maybe_unused]] const auto& acc, const auto& result) {
+    auto const action = std::get<0>(result);
+    if (action != Actions::MALLOC and action != Actions::CALLOC and action != Actions::REALLOC
+        and action != Actions::ALIGNED_ALLOC) {
+      return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(true, Reason::notApplicable)));
+    }
+    auto const& payload = std::get<1>(result);
+    auto range = action == Actions::REALLOC         ? std::get<Reallocation>(payload).range
+                 : action == Actions::ALIGNED_ALLOC ? std::get<AlignedRange>(payload).range
+                                                    : asDynamicSpan(std::get<Range>(payload));
+    if (range.data() == nullptr) {
+      return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(false, Reason::nullpointer)));
+    }
+
+    bool passed = true;
+    std::size_t kept = 0U;
+    if (action == Actions::CALLOC) {
+      passed = std::ranges::all_of(range, [](auto const value) { return value == std::byte{0}; });
+    }
+    if (action == Actions::REALLOC) {
+      kept = std::min(std::get<Reallocation>(payload).previousSize, range.size());
+      for (std::size_t i = 0U; i < kept; ++i) {
+        passed = passed and range[i] == pattern(i);
+      }
+    }
+    if (action == Actions::ALIGNED_ALLOC) {
+      passed = reinterpret_cast<std::uintptr_t>(range.data())
+                   % std::get<AlignedRange>(payload).alignment
+               == 0U;
+    }
+    fill(range, kept);
+    return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(passed, Reason::completed)));
+  }
+};
+
+// Writes to every page of each allocation, so the cost of faulting in fresh memory shows up. The
+// last byte is written, too, in case the allocation doesn't start at a page boundary. Pages must
+// only be touched after any advice was given, so this happens on the ADVISE step following the
+// allocation.
+struct FirstTouchChecker {
+  ALPAKA_FN_ACC auto check([[maybe_unused]] const auto& acc, const auto& result) {
+    if (std::get<0>(result) != Actions::ADVISE) {
+      return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(true, Reason::notApplicable)));
+    }
+    auto range = asDynamicSpan(std::get<Range>(std::get<1>(result)));
+    if (range.data() == nullptr) {
+      return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(false, Reason::nullpointer)));
+    }
+    // Nobody reads this memory before it's freed, so the compiler would happily drop the writes.
+    auto* const data = static_cast<std::byte volatile*>(range.data());
+    for (std::size_t i = 0U; i < range.size(); i += BASE_PAGE_SIZE) {
+      data[i] = std::byte{1};
+    }
+    data[range.size() - 1U] = std::byte{1};
+    return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(true, Reason::completed)));
+  }
+};
+
+// Only records allocations and deallocations during the run, so the verification doesn't disturb
+// the measurements. The records are checked for overlaps on the host afterwards, see
+// `DeferredCheckInstructionDetails`. Every thread writes to slots of its own and stamps the events
+// with the device-wide timer, so threads don't contend on anything.
+struct DeferredOverlapChecker {
+  overlap::Event* events{nullptr};
+  std::uint32_t maxEvents{0U};
+  std::uint32_t thread{0U};
+  std::uint32_t numEvents{0U};
+  std::uint32_t droppedEvents{0U};
+  std::uint64_t previousStamp{0U};
+
+  ALPAKA_FN_ACC auto check([[maybe_unused]] const auto& acc, const auto& result) {
+    auto const action = std::get<0>(result);
+    if (action != Actions::MALLOC and action != Actions::FREE) {
+      return std::make_tuple(Actions::CHECK, Payload(std::make_pair(true, Reason::notApplicable)));
+    }
+    auto range = asDynamicSpan(std::get<0>(std::get<1>(result)));
+    if (range.data() == nullptr) {
+      return std::make_tuple(Actions::CHECK,
+                             Payload(action == Actions::MALLOC
+                                         ? std::make_pair(false, Reason::nullpointer)
+                                         : std::make_pair(true, Reason::notApplicable)));
+    }
+    auto const stamp = DeviceClock<AccTag>::timestamp();
+    if (numEvents < maxEvents) {
+      auto const begin = reinterpret_cast<std::uintptr_t>(range.data());
+      events[numEvents] = {begin,  begin + range.size(), stamp, previousStamp,
+                           thread, numEvents,            action == Actions::FREE};
+      numEvents++;
+    } else {
+      droppedEvents++;
+    }
+    previousStamp = stamp;
+    return std::make_tuple(+Actions::CHECK, Payload(std::make_pair(true, Reason::deferred)));
+  }
+};
+
 template <typename T> struct NoStoreProvider {
   ALPAKA_FN_ACC T load(auto const) { return {}; }
   ALPAKA_FN_ACC void store(auto const&, T&&, auto const) {}
   nlohmann::json generateReport() { return {}; }
 };
 
+// Hands every thread a copy of a pre-configured instance.
+template <typename T> struct PrototypeProvider {
+  T prototype{};
+  ALPAKA_FN_ACC T load(auto const) { return prototype; }
+  ALPAKA_FN_ACC void store(auto const&, T&&, auto const) {}
+  nlohmann::json generateReport() { return {}; }
+};
+
 template <typename T> struct AccumulateResultsProvider {
   T result{};
   ALPAKA_FN_ACC T load(auto const) { return {}; }
@@ -220,45 +729,69 @@ template <typename T> struct AcumulateChecksProvider {
   nlohmann::json generateReport() { return result.generateReport(); }
 };
 
-namespace setups {
-  struct SingleSizeMallocRecipe {
-    static constexpr std::uint32_t allocationSize{ALLOCATION_SIZE};
-    static constexpr std::uint32_t numAllocations{256U};
-    std::array<std::byte*, numAllocations> pointers{{}};
-    std::uint32_t counter{0U};
-
-    ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
-      if (counter >= numAllocations)
-        return std::make_tuple(+kitgenbench::Actions::STOP,
-                               Payload(std::span<std::byte, allocationSize>{
-                                   static_cast<std::byte*>(nullptr), allocationSize}));
-      pointers[counter] = static_cast<std::byte*>(malloc(allocationSize));
-      auto result = std::make_tuple(
-          +kitgenbench::Actions::MALLOC,
-          Payload(std::span<std::byte, allocationSize>(pointers[counter], allocationSize)));
-      counter++;
-      return result;
-    }
-
-    nlohmann::json generateReport() { return {}; }
-  };
+// Hands every `DeferredOverlapChecker` its share of the event buffer, which itself lives outside
+// the device package. The event counts are only summed up once a thread is done.
+struct DeferredChecksProvider {
+  overlap::Event* events{nullptr};
+  std::uint32_t maxEventsPerThread{0U};
+  unsigned long long recordedEvents{0U};
+  unsigned long long droppedEvents{0U};
+  ALPAKA_FN_ACC DeferredOverlapChecker load(auto const threadIndex) {
+    return {events + threadIndex * maxEventsPerThread, maxEventsPerThread,
+            static_cast<std::uint32_t>(threadIndex)};
+  }
+  ALPAKA_FN_ACC void store(const auto& acc, DeferredOverlapChecker&& instance, auto const) {
+    alpaka::atomicAdd(acc, &recordedEvents, static_cast<unsigned long long>(instance.numEvents));
+    alpaka::atomicAdd(acc, &droppedEvents, static_cast<unsigned long long>(instance.droppedEvents));
+  }
+  nlohmann::json generateReport() {
+    return {{"recorded events", recordedEvents}, {"dropped events", droppedEvents}};
+  }
+};
 
-  template <typename TAcc, typename TDev> struct InstructionDetails {
-    struct DevicePackage {
-      NoStoreProvider<SingleSizeMallocRecipe> recipes{};
-      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
-      AcumulateChecksProvider<IotaReductionChecker> checkers{};
-    };
+// Owns the heap fill counters shared by all `HeapFillLogger` instances.
+template <typename T> struct HeapFillLoggerProvider {
+  unsigned long long bytesInUse{0U};
+  unsigned long long firstFailureBytesInUse{T::noFailure};
+  T result{};
+  ALPAKA_FN_ACC T load(auto const) {
+    return {&bytesInUse, &firstFailureBytesInUse, result.heapSize};
+  }
+  ALPAKA_FN_ACC void store(const auto& acc, T&& instance, auto const) {
+    result.accumulate(acc, instance);
+  }
+  nlohmann::json generateReport() {
+    auto report = result.generateReport();
+    // Anything but zero means that some allocations were not freed (or not logged).
+    report["heap fill at the end [bytes]"] = bytesInUse;
+    auto const failed = firstFailureBytesInUse != T::noFailure;
+    // The null values below vanish when the report is merged, so this tells why they are missing.
+    report["allocation failed"] = failed;
+    report["first failure heap fill [bytes]"]
+        = failed ? nlohmann::json(firstFailureBytesInUse) : nlohmann::json(nullptr);
+    report["first failure heap fill [fraction]"]
+        = failed ? nlohmann::json(static_cast<double>(firstFailureBytesInUse) / result.heapSize)
+                 : nlohmann::json(nullptr);
+    return report;
+  }
+};
 
-    DevicePackage hostData{};
-    alpaka::Buf<TDev, DevicePackage, alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> devicePackageBuffer;
+namespace setups {
+  template <typename TAcc, typename TDev, typename TDevicePackage> struct InstructionDetails {
+    TDevicePackage hostData{};
+    alpaka::Buf<TDev, TDevicePackage, alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> devicePackageBuffer;
 
-    InstructionDetails(TDev const& device)
-        : devicePackageBuffer(alpaka::allocBuf<DevicePackage, Idx>(device, 1U)) {};
+    InstructionDetails(TDev const& device, TDevicePackage const& package)
+        : hostData(package),
+          devicePackageBuffer(alpaka::allocBuf<TDevicePackage, Idx>(device, 1U)) {};
 
     auto sendTo([[maybe_unused]] TDev const& device, auto& queue) {
-      alpaka::memset(queue, devicePackageBuffer, 0U);
-      return reinterpret_cast<DevicePackage*>(alpaka::getPtrNative(devicePackageBuffer));
+      // Some providers are configured on the host, so we can't just zero the device memory.
+      auto const platformHost = alpaka::PlatformCpu{};
+      auto const devHost = getDevByIdx(platformHost, 0);
+      auto view = alpaka::createView(devHost, &hostData, 1U);
+      alpaka::memcpy(queue, devicePackageBuffer, view);
+      return reinterpret_cast<TDevicePackage*>(alpaka::getPtrNative(devicePackageBuffer));
     }
     auto retrieveFrom([[maybe_unused]] TDev const& device, auto& queue) {
       auto const platformHost = alpaka::PlatformCpu{};
@@ -274,15 +807,698 @@ namespace setups {
     }
   };
 
-  template <typename TAcc, typename TDev> auto makeInstructionDetails(TDev const& device) {
-    return InstructionDetails<TAcc, TDev>(device);
+  template <typename TAcc, typename TDev, typename TDevicePackage>
+  auto makeInstructionDetails(TDev const& device, TDevicePackage const& package) {
+    return InstructionDetails<TAcc, TDev, TDevicePackage>(device, package);
   }
 
-  auto composeSetup() {
-    auto execution = makeExecutionDetails();
-    return setup::composeSetup("Non trivial", execution,
-                               makeInstructionDetails<Acc>(execution.device), {});
+  // Additionally owns the buffer the `DeferredOverlapChecker`s record into and verifies the
+  // recorded events once they are back on the host.
+  template <typename TAcc, typename TDev, typename TDevicePackage>
+  struct DeferredCheckInstructionDetails : InstructionDetails<TAcc, TDev, TDevicePackage> {
+    alpaka::Buf<TDev, overlap::Event, alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> eventBuffer;
+    std::vector<overlap::Event> events{};
+
+    DeferredCheckInstructionDetails(TDev const& device, TDevicePackage const& package,
+                                    Idx const numThreads, std::uint32_t const maxEventsPerThread)
+        : InstructionDetails<TAcc, TDev, TDevicePackage>(device, package),
+          eventBuffer(
+              alpaka::allocBuf<overlap::Event, Idx>(device, numThreads * maxEventsPerThread)) {
+      this->hostData.checkers.events = alpaka::getPtrNative(eventBuffer);
+      this->hostData.checkers.maxEventsPerThread = maxEventsPerThread;
+    };
+
+    auto sendTo(TDev const& device, auto& queue) {
+      // Slots that no thread wrote to stay zero and are skipped after the run.
+      alpaka::memset(queue, eventBuffer, 0);
+      return InstructionDetails<TAcc, TDev, TDevicePackage>::sendTo(device, queue);
+    }
+
+    auto retrieveFrom(TDev const& device, auto& queue) {
+      InstructionDetails<TAcc, TDev, TDevicePackage>::retrieveFrom(device, queue);
+      auto const capacity = static_cast<Idx>(alpaka::getExtentProduct(eventBuffer));
+      events.resize(capacity);
+      auto const platformHost = alpaka::PlatformCpu{};
+      auto const devHost = getDevByIdx(platformHost, 0);
+      auto view = alpaka::createView(devHost, events.data(), capacity);
+      alpaka::memcpy(queue, view, eventBuffer);
+      alpaka::wait(queue);
+      std::erase_if(events, [](auto const& event) { return event.end == 0U; });
+    }
+
+    nlohmann::json generateReport() {
+      auto report = InstructionDetails<TAcc, TDev, TDevicePackage>::generateReport();
+      std::size_t unmatched = 0U;
+      auto allocations = overlap::pairEvents(std::move(events), unmatched);
+      report["checks"]["overlaps"] = overlap::findOverlaps(allocations);
+      report["checks"]["unmatched deallocations"] = unmatched;
+      return report;
+    }
+  };
+
+  template <typename TAcc, typename TDev, typename TDevicePackage>
+  auto makeDeferredCheckInstructionDetails(TDev const& device, TDevicePackage const& package,
+                                           Idx const numThreads,
+                                           std::uint32_t const maxEventsPerThread) {
+    return DeferredCheckInstructionDetails<TAcc, TDev, TDevicePackage>(device, package, numThreads,
+                                                                       maxEventsPerThread);
   }
+
+  namespace singleSizeMalloc {
+    template <std::size_t TExtent = ALLOCATION_SIZE> struct SingleSizeMallocRecipe {
+      static constexpr std::uint32_t maxNumAllocations{256U};
+      std::array<std::byte*, maxNumAllocations> pointers{{}};
+      std::uint32_t counter{0U};
+      std::uint32_t numAllocations{maxNumAllocations};
+      // Setups that run many times in a row must return their memory, so the later ones don't
+      // measure an exhausted heap.
+      bool freeAfterwards{false};
+      std::uint32_t freed{0U};
+      // Only used with dynamic extent, otherwise the size is known at compile time.
+      std::size_t dynamicAllocationSize{0U};
+
+      ALPAKA_FN_INLINE ALPAKA_FN_ACC auto allocationSize() const -> std::size_t {
+        if constexpr (TExtent == std::dynamic_extent) {
+          return dynamicAllocationSize;
+        } else {
+          return TExtent;
+        }
+      }
+
+      ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+        if (counter >= numAllocations and freeAfterwards and freed < counter) {
+          free(pointers[freed]);
+          auto result = std::make_tuple(
+              +kitgenbench::Actions::FREE,
+              Payload(std::span<std::byte, TExtent>(pointers[freed], allocationSize())));
+          freed++;
+          return result;
+        }
+        if (counter >= numAllocations)
+          return std::make_tuple(+kitgenbench::Actions::STOP,
+                                 Payload(std::span<std::byte, TExtent>{
+                                     static_cast<std::byte*>(nullptr), allocationSize()}));
+        pointers[counter] = static_cast<std::byte*>(malloc(allocationSize()));
+        auto result = std::make_tuple(
+            +kitgenbench::Actions::MALLOC,
+            Payload(std::span<std::byte, TExtent>(pointers[counter], allocationSize())));
+        counter++;
+        return result;
+      }
+
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    struct DevicePackage {
+      NoStoreProvider<SingleSizeMallocRecipe<>> recipes{};
+      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
+      AcumulateChecksProvider<IotaReductionChecker> checkers{};
+    };
+
+    auto composeSetup() {
+      auto execution = makeExecutionDetails();
+      return setup::composeSetup("Non trivial", execution,
+                                 makeInstructionDetails<Acc>(execution.device, DevicePackage{}),
+                                 {});
+    }
+
+    struct DeferredCheckDevicePackage {
+      NoStoreProvider<SingleSizeMallocRecipe<>> recipes{};
+      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
+      DeferredChecksProvider checkers{};
+    };
+
+    auto composeDeferredCheckSetup() {
+      auto execution = makeExecutionDetails();
+      return setup::composeSetup(
+          "Non trivial with deferred overlap check", execution,
+          makeDeferredCheckInstructionDetails<Acc>(
+              execution.device, DeferredCheckDevicePackage{},
+              static_cast<Idx>(getNumVirtualThreads(execution.workdiv)),
+              SingleSizeMallocRecipe<>::maxNumAllocations),
+          {{"what it does",
+            "Same as the non-trivial setup but all allocations are only recorded during the run "
+            "and checked for overlaps afterwards."}});
+    }
+
+    template <std::size_t TExtent> struct SweepDevicePackage {
+      PrototypeProvider<SingleSizeMallocRecipe<TExtent>> recipes{};
+      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
+      AcumulateChecksProvider<IotaReductionChecker> checkers{};
+    };
+
+    // `TExtent` is either `allocationSize` itself or `std::dynamic_extent` for sizes that are not
+    // in `AllocationSizes`. Use `AllocationSizes::dispatch` to get it.
+    template <std::size_t TExtent> auto composeSweepSetup(std::size_t const allocationSize) {
+      auto execution = makeExecutionDetails();
+      // Don't let large sizes use up more than half of the heap.
+      auto const numAllocations = static_cast<std::uint32_t>(std::clamp(
+          HEAP_SIZE / 2U / (getNumVirtualThreads(execution.workdiv) * allocationSize), 1ULL,
+          static_cast<unsigned long long>(SingleSizeMallocRecipe<TExtent>::maxNumAllocations)));
+      SweepDevicePackage<TExtent> package{};
+      package.recipes.prototype.numAllocations = numAllocations;
+      // The budget is per setup, so each sweep point has to leave the heap as it found it.
+      package.recipes.prototype.freeAfterwards = true;
+      package.recipes.prototype.dynamicAllocationSize = allocationSize;
+      return setup::composeSetup(
+          "Single size malloc of " + std::to_string(allocationSize) + " bytes", execution,
+          makeInstructionDetails<Acc>(execution.device, package),
+          {{"allocation size [bytes]", allocationSize},
+           {"number of allocations per thread", numAllocations},
+           {"fixed extent", TExtent != std::dynamic_extent}});
+    }
+  }  // namespace singleSizeMalloc
+
+  namespace heapRamp {
+    // Keeps allocating until the allocator fails (or the thread's budget is used up) and then frees
+    // everything again. The allocations are chained into an intrusive singly-linked list, so we
+    // don't need to know beforehand how many we are going to get.
+    struct HeapRampRecipe {
+      static constexpr std::uint32_t allocationSize{ALLOCATION_SIZE};
+      static_assert(allocationSize >= sizeof(std::byte*));
+      std::uint32_t maxAllocations{0U};
+      std::uint32_t counter{0U};
+      std::byte* latest{nullptr};
+      std::byte* list{nullptr};
+      bool exhausted{false};
+
+      ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+        if (not exhausted) {
+          // The checker might have written to the latest allocation, so it's only linked in now.
+          if (latest != nullptr) {
+            *reinterpret_cast<std::byte**>(latest) = list;
+            list = latest;
+            latest = nullptr;
+          }
+          if (counter < maxAllocations) {
+            latest = static_cast<std::byte*>(malloc(allocationSize));
+            counter++;
+            exhausted = (latest == nullptr);
+            return std::make_tuple(
+                +kitgenbench::Actions::MALLOC,
+                Payload(std::span<std::byte, allocationSize>(latest, allocationSize)));
+          }
+          exhausted = true;
+        }
+
+        if (list == nullptr)
+          return std::make_tuple(+kitgenbench::Actions::STOP,
+                                 Payload(std::span<std::byte, allocationSize>{
+                                     static_cast<std::byte*>(nullptr), allocationSize}));
+        auto* pointer = list;
+        list = *reinterpret_cast<std::byte**>(pointer);
+        OnReturn const freeOnReturn{[pointer] { free(pointer); }};
+        return std::make_tuple(
+            +kitgenbench::Actions::FREE,
+            Payload(std::span<std::byte, allocationSize>(pointer, allocationSize)));
+      }
+
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    struct DevicePackage {
+      PrototypeProvider<HeapRampRecipe> recipes{};
+      HeapFillLoggerProvider<HeapFillLogger<AccTag>> loggers{};
+      AcumulateChecksProvider<IotaReductionChecker> checkers{};
+    };
+
+    // Each thread may allocate this multiple of its fair share of the heap before giving up. This
+    // must be larger than one for a bounded heap to actually run out.
+    static constexpr std::uint32_t OVERCOMMIT_FACTOR = 2U;
+
+    auto composeSetup() {
+      auto execution = makeExecutionDetails();
+      // Without interleaving, a serial run would execute one thread after another, so each of
+      // them would start from and return to an almost empty heap. Elsewhere, every thread runs a
+      // single virtual thread, and interleaving would only move its state out of registers.
+      if constexpr (std::is_same_v<AccTag, alpaka::TagCpuSerial>) {
+        execution.interleaving = {Interleaving::Mode::roundRobin};
+      }
+      auto const maxAllocations = static_cast<std::uint32_t>(
+          OVERCOMMIT_FACTOR * HEAP_SIZE / getNumVirtualThreads(execution.workdiv)
+          / HeapRampRecipe::allocationSize);
+      DevicePackage package{};
+      package.recipes.prototype.maxAllocations = maxAllocations;
+      nlohmann::json description{
+          {"what it does",
+           "Every thread allocates until the allocator fails or it has allocated its maximal "
+           "number of allocations, and frees everything afterwards. Allocation latency is logged "
+           "as a function of the heap fill level."},
+          {"allocation size [bytes]", HeapRampRecipe::allocationSize},
+          {"heap size [bytes]", HEAP_SIZE},
+          {"heap is bounded", HEAP_IS_BOUNDED},
+          {"maximal number of allocations per thread", maxAllocations}};
+      if constexpr (not HEAP_IS_BOUNDED) {
+        description["note"]
+            = "The heap size is only nominal, the allocator doesn't fail when it's reached. So, "
+              "every thread stops at its maximal number of allocations and everything beyond the "
+              "heap size ends up in the last bucket.";
+      }
+      return setup::composeSetup("Heap ramp", execution,
+                                 makeInstructionDetails<Acc>(execution.device, package),
+                                 description);
+    }
+  }  // namespace heapRamp
+
+  namespace remoteFree {
+    struct HandoffGroup {
+      HandoffQueue<std::byte*> queue{};
+      std::uint32_t producersDone{0U};
+    };
+
+    // Producers allocate and hand a configurable share of their allocations over to the consumers
+    // of their group, freeing the rest themselves. Consumers free whatever they receive until all
+    // producers of their group are done. Every queue operation is a step of its own, so the
+    // logged deallocation times don't include any time spent on the handoff.
+    struct RemoteFreeRecipe {
+      static constexpr std::uint32_t allocationSize{ALLOCATION_SIZE};
+      HandoffGroup* group{nullptr};
+      bool isProducer{false};
+      std::uint32_t numProducers{0U};
+      std::uint32_t numAllocations{0U};
+      std::uint32_t handoffPercentage{0U};
+      std::uint32_t counter{0U};
+      std::byte* pending{nullptr};
+
+      ALPAKA_FN_ACC auto next(const auto& acc) {
+        if (group == nullptr) {
+          return result(kitgenbench::Actions::STOP, nullptr);
+        }
+        return isProducer ? produce(acc) : consume(acc);
+      }
+
+      ALPAKA_FN_ACC auto produce(const auto& acc) {
+        if (pending != nullptr) {
+          auto* pointer = std::exchange(pending, nullptr);
+          if (isHandedOff(counter - 1U) and group->queue.tryPush(acc, pointer)) {
+            return result(kitgenbench::Actions::HANDOFF, pointer);
+          }
+          OnReturn const freeOnReturn{[pointer] { free(pointer); }};
+          return result(kitgenbench::Actions::FREE, pointer);
+        }
+        if (counter < numAllocations) {
+          pending = static_cast<std::byte*>(malloc(allocationSize));
+          counter++;
+          return result(kitgenbench::Actions::MALLOC, pending);
+        }
+        // Make sure that our last push is visible before we announce to be done.
+        alpaka::mem_fence(acc, alpaka::memory_scope::Device{});
+        alpaka::atomicAdd(acc, &group->producersDone, 1U);
+        return result(kitgenbench::Actions::STOP, nullptr);
+      }
+
+      ALPAKA_FN_ACC auto consume(const auto& acc) {
+        if (pending != nullptr) {
+          auto* pointer = std::exchange(pending, nullptr);
+          OnReturn const freeOnReturn{[pointer] { free(pointer); }};
+          return result(kitgenbench::Actions::REMOTE_FREE, pointer);
+        }
+        // This must be read before looking into the queue. Otherwise, a producer could push and
+        // finish in between and we'd miss its last allocation.
+        auto const producersDone
+            = alpaka::atomicAdd(acc, &group->producersDone, 0U) == numProducers;
+        alpaka::mem_fence(acc, alpaka::memory_scope::Device{});
+        if (group->queue.tryPop(acc, pending)) {
+          return result(kitgenbench::Actions::HANDOFF, pending);
+        }
+        if (producersDone) {
+          return result(kitgenbench::Actions::STOP, nullptr);
+        }
+        // Nothing to do yet.
+        return result(kitgenbench::Actions::HANDOFF, nullptr);
+      }
+
+      // Spreads the handed off allocations evenly over all of them.
+      ALPAKA_FN_ACC auto isHandedOff(std::uint32_t const index) const {
+        return (index + 1U) * handoffPercentage / 100U > index * handoffPercentage / 100U;
+      }
+
+      ALPAKA_FN_ACC static auto result(int const action, std::byte* pointer) {
+        return std::make_tuple(
+            action, Payload(std::span<std::byte, allocationSize>(pointer, allocationSize)));
+      }
+
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    // Threads are partitioned into consecutive groups of producers followed by consumers. So, in a
+    // serial run, the producers of a group are done before its consumers start. Threads that don't
+    // fit into a full group stay idle.
+    struct RemoteFreeRecipeProvider {
+      HandoffGroup* groups{nullptr};
+      std::uint32_t numGroups{0U};
+      RemoteFreeRecipe prototype{};
+      std::uint32_t numConsumers{0U};
+
+      ALPAKA_FN_ACC RemoteFreeRecipe load(auto const threadIndex) {
+        auto recipe = prototype;
+        auto const groupSize = prototype.numProducers + numConsumers;
+        auto const groupIndex = threadIndex / groupSize;
+        if (groupIndex < numGroups) {
+          recipe.group = &groups[groupIndex];
+          recipe.isProducer = threadIndex % groupSize < prototype.numProducers;
+        }
+        return recipe;
+      }
+      ALPAKA_FN_ACC void store(auto const&, RemoteFreeRecipe&&, auto const) {}
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    struct DevicePackage {
+      RemoteFreeRecipeProvider recipes{};
+      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
+      AcumulateChecksProvider<IotaReductionChecker> checkers{};
+    };
+
+    // Additionally owns the handoff groups and their queues' cells.
+    template <typename TAcc, typename TDev>
+    struct RemoteFreeInstructionDetails : InstructionDetails<TAcc, TDev, DevicePackage> {
+      using Cell = HandoffQueue<std::byte*>::Cell;
+      std::vector<HandoffGroup> groups{};
+      std::vector<Cell> cells{};
+      alpaka::Buf<TDev, HandoffGroup, alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> groupsBuffer;
+      alpaka::Buf<TDev, Cell, alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> cellsBuffer;
+
+      RemoteFreeInstructionDetails(TDev const& device, DevicePackage const& package,
+                                   Idx const numGroups, Idx const queueCapacity)
+          : InstructionDetails<TAcc, TDev, DevicePackage>(device, package),
+            groups(numGroups),
+            groupsBuffer(alpaka::allocBuf<HandoffGroup, Idx>(device, numGroups)),
+            cellsBuffer(alpaka::allocBuf<Cell, Idx>(device, numGroups * queueCapacity)) {
+        auto const groupCells = HandoffQueue<std::byte*>::initCells(queueCapacity);
+        for (Idx i = 0U; i < numGroups; ++i) {
+          groups[i].queue.cells = alpaka::getPtrNative(cellsBuffer) + i * queueCapacity;
+          groups[i].queue.capacity = queueCapacity;
+          cells.insert(cells.end(), groupCells.cbegin(), groupCells.cend());
+        }
+        this->hostData.recipes.groups = alpaka::getPtrNative(groupsBuffer);
+        this->hostData.recipes.numGroups = numGroups;
+      };
+
+      auto sendTo(TDev const& device, auto& queue) {
+        auto const platformHost = alpaka::PlatformCpu{};
+        auto const devHost = getDevByIdx(platformHost, 0);
+        auto groupsView = alpaka::createView(devHost, groups.data(), groups.size());
+        alpaka::memcpy(queue, groupsBuffer, groupsView);
+        auto cellsView = alpaka::createView(devHost, cells.data(), cells.size());
+        alpaka::memcpy(queue, cellsBuffer, cellsView);
+        return InstructionDetails<TAcc, TDev, DevicePackage>::sendTo(device, queue);
+      }
+    };
+
+    template <typename TAcc, typename TDev>
+    auto makeInstructionDetails(TDev const& device, DevicePackage const& package,
+                                Idx const numGroups, Idx const queueCapacity) {
+      return RemoteFreeInstructionDetails<TAcc, TDev>(device, package, numGroups, queueCapacity);
+    }
+
+    auto composeSetup(std::uint32_t const numProducers, std::uint32_t const numConsumers,
+                      std::uint32_t const handoffPercentage) {
+      static constexpr std::uint32_t numAllocations{256U};
+      auto execution = makeExecutionDetails();
+      auto const numGroups = static_cast<Idx>(getNumVirtualThreads(execution.workdiv)
+                                              / (numProducers + numConsumers));
+      // Large enough to never be full, so producers only free locally what they are supposed to.
+      auto const queueCapacity = static_cast<Idx>(numProducers * numAllocations);
+
+      DevicePackage package{};
+      package.recipes.numGroups = numGroups;
+      package.recipes.numConsumers = numConsumers;
+      package.recipes.prototype.numProducers = numProducers;
+      package.recipes.prototype.numAllocations = numAllocations;
+      package.recipes.prototype.handoffPercentage = handoffPercentage;
+      return setup::composeSetup(
+          "Remote free " + std::to_string(numProducers) + ":" + std::to_string(numConsumers) + " ("
+              + std::to_string(handoffPercentage) + "% handed off)",
+          execution,
+          makeInstructionDetails<Acc>(execution.device, package, numGroups, queueCapacity),
+          {{"what it does",
+            "Producer threads allocate and hand a share of their allocations over to consumer "
+            "threads via lock-free queues. Consumers free what they receive, producers free the "
+            "rest. Deallocations by consumers are logged as remote deallocations."},
+           {"allocation size [bytes]", RemoteFreeRecipe::allocationSize},
+           {"number of allocations per producer", numAllocations},
+           {"producers per group", numProducers},
+           {"consumers per group", numConsumers},
+           {"number of groups", numGroups},
+           {"handed off allocations [%]", handoffPercentage}});
+    }
+  }  // namespace remoteFree
+
+  namespace growth {
+    // Grows a buffer like a `std::vector` that is appended to: It starts out zeroed from `calloc`
+    // and is `realloc`ed to `size * growthNumerator / growthDenominator + growthIncrement` until
+    // that would exceed `maxSize`. Then, it's freed and the next round starts.
+    struct GrowthRecipe {
+      std::size_t initialSize{ALLOCATION_SIZE};
+      std::size_t maxSize{4096U};
+      std::size_t growthNumerator{2U};
+      std::size_t growthDenominator{1U};
+      std::size_t growthIncrement{0U};
+      std::uint32_t numRounds{8U};
+      std::uint32_t round{0U};
+      std::byte* pointer{nullptr};
+      std::size_t size{0U};
+      bool failed{false};
+
+      ALPAKA_FN_INLINE ALPAKA_FN_ACC auto grownSize() const {
+        return size * growthNumerator / growthDenominator + growthIncrement;
+      }
+
+      ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+        if (round >= numRounds) {
+          return std::make_tuple(+kitgenbench::Actions::STOP,
+                                 Payload(Range{std::span<std::byte>{}}));
+        }
+        if (pointer == nullptr) {
+          size = initialSize;
+          pointer = static_cast<std::byte*>(allocation::callocate(size));
+          auto result = std::make_tuple(+kitgenbench::Actions::CALLOC,
+                                        Payload(Range{std::span<std::byte>(pointer, size)}));
+          // There's nothing to grow, so we skip this round.
+          round += (pointer == nullptr);
+          return result;
+        }
+        if (failed or grownSize() > maxSize) {
+          auto* const freed = std::exchange(pointer, nullptr);
+          failed = false;
+          round++;
+          OnReturn const freeOnReturn{[freed] { free(freed); }};
+          return std::make_tuple(+kitgenbench::Actions::FREE,
+                                 Payload(Range{std::span<std::byte>(freed, size)}));
+        }
+        auto const previous = reinterpret_cast<std::uintptr_t>(pointer);
+        auto const newSize = grownSize();
+        auto* grown = static_cast<std::byte*>(allocation::reallocate(pointer, size, newSize));
+        // On failure, the old buffer is still valid and freed in the next step.
+        failed = grown == nullptr;
+        if (not failed) {
+          pointer = grown;
+        }
+        auto result = std::make_tuple(
+            +kitgenbench::Actions::REALLOC,
+            Payload(Reallocation{std::span<std::byte>(grown, newSize), previous, size}));
+        size = failed ? size : newSize;
+        return result;
+      }
+
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    struct DevicePackage {
+      PrototypeProvider<GrowthRecipe> recipes{};
+      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
+      NoStoreProvider<ContentChecker> checkers{};
+    };
+
+    auto composeSetup(std::string const& name, GrowthRecipe const& prototype) {
+      auto execution = makeExecutionDetails();
+      return setup::composeSetup(
+          name, execution,
+          makeInstructionDetails<Acc>(execution.device, DevicePackage{{prototype}}),
+          {{"what it does",
+            "Grows a zeroed buffer via realloc until it reaches the maximal size, then frees it "
+            "and starts over."},
+           {"initial size [bytes]", prototype.initialSize},
+           {"maximal size [bytes]", prototype.maxSize},
+           {"growth factor", static_cast<double>(prototype.growthNumerator)
+                                 / static_cast<double>(prototype.growthDenominator)},
+           {"growth increment [bytes]", prototype.growthIncrement},
+           {"number of rounds", prototype.numRounds}});
+    }
+
+    // Doubling the size like most `std::vector` implementations do. This rarely leaves room to
+    // grow in place.
+    auto composeGeometricSetup() { return composeSetup("Geometric growth", {}); }
+
+    // Small increments give the allocator the chance to grow in place most of the time, so
+    // comparing with the geometric growth shows how much that is worth.
+    auto composeIncrementalSetup() {
+      GrowthRecipe prototype{};
+      prototype.growthNumerator = 1U;
+      prototype.growthIncrement = ALLOCATION_SIZE;
+      prototype.maxSize = 1024U;
+      prototype.numRounds = 2U;
+      return composeSetup("Incremental growth", prototype);
+    }
+  }  // namespace growth
+
+  namespace alignment {
+    // Obtains `numAllocations` aligned buffers and frees them again afterwards.
+    struct AlignedAllocRecipe {
+      static constexpr std::uint32_t maxNumAllocations{64U};
+      std::array<std::byte*, maxNumAllocations> pointers{{}};
+      std::size_t alignment{BASE_PAGE_SIZE};
+      std::size_t allocationSize{64U};
+      std::uint32_t numAllocations{maxNumAllocations};
+      std::uint32_t counter{0U};
+
+      ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+        if (counter < numAllocations) {
+          pointers[counter]
+              = static_cast<std::byte*>(allocation::alignedAllocate(alignment, allocationSize));
+          return std::make_tuple(
+              +kitgenbench::Actions::ALIGNED_ALLOC,
+              Payload(AlignedRange{std::span<std::byte>(pointers[counter++], allocationSize),
+                                   alignment}));
+        }
+        if (counter < 2U * numAllocations) {
+          auto* pointer = pointers[counter++ - numAllocations];
+          OnReturn const freeOnReturn{[pointer] { allocation::alignedFree(pointer); }};
+          return std::make_tuple(+kitgenbench::Actions::FREE,
+                                 Payload(Range{std::span<std::byte>(pointer, allocationSize)}));
+        }
+        return std::make_tuple(+kitgenbench::Actions::STOP, Payload(Range{std::span<std::byte>{}}));
+      }
+
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    struct DevicePackage {
+      PrototypeProvider<AlignedAllocRecipe> recipes{};
+      AccumulateResultsProvider<SimpleSumLogger<AccTag>> loggers{};
+      NoStoreProvider<ContentChecker> checkers{};
+    };
+
+    auto composeSweepSetup(std::size_t const alignment) {
+      auto execution = makeExecutionDetails();
+      DevicePackage package{};
+      package.recipes.prototype.alignment = alignment;
+      return setup::composeSetup(
+          "Aligned allocation to " + std::to_string(alignment) + " bytes", execution,
+          makeInstructionDetails<Acc>(execution.device, package),
+          {{"alignment [bytes]", alignment},
+           {"allocation size [bytes]", package.recipes.prototype.allocationSize},
+           {"number of allocations per thread", package.recipes.prototype.numAllocations}});
+    }
+  }  // namespace alignment
+
+  namespace firstTouch {
+    // Instead of changing the system-wide transparent huge page mode, which requires root, we
+    // emulate it per allocation: With the system in `madvise` mode (the usual default), no hint
+    // means no huge pages, `MADV_HUGEPAGE` behaves like `always` and `MADV_NOHUGEPAGE` like
+    // `never`.
+    enum class HugePageHint { none, huge, noHuge };
+
+    inline std::string to_string(HugePageHint const hint) {
+      switch (hint) {
+        case HugePageHint::huge:
+          return "MADV_HUGEPAGE";
+        case HugePageHint::noHuge:
+          return "MADV_NOHUGEPAGE";
+        default:
+          return "none";
+      }
+    }
+
+    // Obtains `numAllocations` large buffers, which are touched by the `FirstTouchChecker`, and
+    // frees them at the end. Every allocation is followed by an ADVISE step giving the hint, so the
+    // `madvise` call is neither part of the allocation nor of the first touch.
+    struct FirstTouchRecipe {
+      static constexpr std::uint32_t maxNumAllocations{4U};
+      std::array<std::byte*, maxNumAllocations> pointers{{}};
+      // Large, so touching the pages dominates everything else. Memory recycled by the allocator
+      // was touched before, though, so there must not be free regions of this size around.
+      std::size_t allocationSize{64U * 1024U * 1024U};
+      std::uint32_t numAllocations{1U};
+      HugePageHint hint{HugePageHint::none};
+      std::uint32_t counter{0U};
+      bool advised{true};
+
+      ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+        if (not advised) {
+          advised = true;
+          if (hint != HugePageHint::none) {
+            allocation::adviseHugePages(pointers[counter], allocationSize,
+                                        hint == HugePageHint::huge);
+          }
+          return std::make_tuple(
+              +kitgenbench::Actions::ADVISE,
+              Payload(Range{std::span<std::byte>(pointers[counter++], allocationSize)}));
+        }
+        if (counter < numAllocations) {
+          pointers[counter] = static_cast<std::byte*>(malloc(allocationSize));
+          advised = false;
+          return std::make_tuple(
+              +kitgenbench::Actions::MALLOC,
+              Payload(Range{std::span<std::byte>(pointers[counter], allocationSize)}));
+        }
+        if (counter < 2U * numAllocations) {
+          auto* pointer = pointers[counter++ - numAllocations];
+          OnReturn const freeOnReturn{[pointer] { free(pointer); }};
+          return std::make_tuple(+kitgenbench::Actions::FREE,
+                                 Payload(Range{std::span<std::byte>(pointer, allocationSize)}));
+        }
+        return std::make_tuple(+kitgenbench::Actions::STOP, Payload(Range{std::span<std::byte>{}}));
+      }
+
+      nlohmann::json generateReport() { return {}; }
+    };
+
+    struct DevicePackage {
+      PrototypeProvider<FirstTouchRecipe> recipes{};
+      AccumulateResultsProvider<FirstTouchLogger<AccTag>> loggers{};
+      NoStoreProvider<FirstTouchChecker> checkers{};
+    };
+
+    auto composeSetup(HugePageHint const hint) {
+      auto execution = makeExecutionDetails();
+      // Every thread faults in lots of memory, so fewer of them keep run time and memory in check.
+      uint32_t const numThreads = 8U;
+      if constexpr (std::is_same_v<alpaka::AccToTag<Acc>, alpaka::TagCpuSerial>) {
+        execution.workdiv = {{1U}, {1U}, {numThreads}};
+      } else {
+        execution.workdiv = {{1U}, {numThreads}, {1U}};
+      }
+      execution.pageFaultProbe = PageFaultProbe{};
+      DevicePackage package{};
+      package.recipes.prototype.hint = hint;
+      return setup::composeSetup(
+          "First touch with huge page hint " + to_string(hint), execution,
+          makeInstructionDetails<Acc>(execution.device, package),
+          {{"what it does",
+            "Allocates large buffers and writes to every page of them, timing the first touch "
+            "separately from the allocation."},
+           {"huge page hint", to_string(hint)},
+           {"allocation size [bytes]", package.recipes.prototype.allocationSize},
+           {"number of allocations per thread", package.recipes.prototype.numAllocations}});
+    }
+
+    // Puts the numbers that differ between the hints next to each other.
+    nlohmann::json compare(nlohmann::json const& reports) {
+      nlohmann::json comparison{};
+      for (auto const hint : {HugePageHint::none, HugePageHint::huge, HugePageHint::noHuge}) {
+        auto const& report = reports["First touch with huge page hint " + to_string(hint)];
+        comparison[to_string(hint)]
+            = {{"allocation average time [ms]", report["logs"]["allocation average time [ms]"]},
+               {"first touch average time per page [ms]",
+                report["logs"]["first touch average time per page [ms]"]},
+               {"minor faults", report["page faults"].value("minor faults", nlohmann::json{})},
+               {"major faults", report["page faults"].value("major faults", nlohmann::json{})}};
+      }
+      return comparison;
+    }
+  }  // namespace firstTouch
 }  // namespace setups
 
 /**
@@ -309,8 +1525,67 @@ void output(json const& report) { std::cout << report << std::endl; }
 
 auto main() -> int {
   auto metadata = gatherMetadata();
-  auto setup = setups::composeSetup();
-  auto benchmarkReports = runBenchmarks(setup);
+  // Point this to a directory to only rerun setups that changed since the last run.
+  auto const* cacheDirectory = std::getenv("KITGENBENCH_RESULT_CACHE");
+  ResultCache cache{cacheDirectory != nullptr ? cacheDirectory : "", metadata};
+  auto singleSizeSetup = setups::singleSizeMalloc::composeSetup();
+  auto deferredCheckSetup = setups::singleSizeMalloc::composeDeferredCheckSetup();
+  auto heapRampSetup = setups::heapRamp::composeSetup();
+  auto remoteFreeSetup = setups::remoteFree::composeSetup(1U, 1U, 50U);
+  auto manyProducersSetup = setups::remoteFree::composeSetup(3U, 1U, 100U);
+  auto geometricGrowthSetup = setups::growth::composeGeometricSetup();
+  auto incrementalGrowthSetup = setups::growth::composeIncrementalSetup();
+  // Small allocations that are never freed next to a growing buffer. Copies of a setup would share
+  // its device buffers, so the groups and their baselines are composed anew.
+  auto coScheduledSetup = coschedule::composeSetup("Non trivial next to geometric growth",
+                                                   setups::singleSizeMalloc::composeSetup(),
+                                                   setups::growth::composeGeometricSetup());
+  auto singleSizeBaseline = setups::singleSizeMalloc::composeSetup();
+  auto geometricGrowthBaseline = setups::growth::composeGeometricSetup();
+  if constexpr (std::is_same_v<AccTag, alpaka::TagCpuSerial>) {
+    // Otherwise, the groups would still run one after the other. The baselines run in the same
+    // order, so the comparison only shows how the groups interfere.
+    coScheduledSetup.execution.interleaving = {Interleaving::Mode::roundRobin};
+    singleSizeBaseline.execution.interleaving = coScheduledSetup.execution.interleaving;
+    geometricGrowthBaseline.execution.interleaving = coScheduledSetup.execution.interleaving;
+  }
+  using setups::firstTouch::HugePageHint;
+  auto systemHugePagesSetup = setups::firstTouch::composeSetup(HugePageHint::none);
+  auto hugePagesSetup = setups::firstTouch::composeSetup(HugePageHint::huge);
+  auto noHugePagesSetup = setups::firstTouch::composeSetup(HugePageHint::noHuge);
+  // The first-touch setups run first because the other ones, in particular the heap ramp, leave
+  // large free regions behind which the allocator would recycle instead of mapping fresh memory.
+  // Setups like these depend on what ran before them, so they are never taken from the cache.
+  // Skipping the setups before them would change the heap they start from.
+  auto benchmarkReports = nlohmann::json::object();
+  for (auto* setup : {&systemHugePagesSetup, &hugePagesSetup, &noHugePagesSetup}) {
+    benchmarkReports[setup->name] = runBenchmark(*setup);
+  }
+  benchmarkReports.update(runBenchmarks(cache, singleSizeSetup, deferredCheckSetup, heapRampSetup,
+                                        remoteFreeSetup, manyProducersSetup,
+                                        geometricGrowthSetup, incrementalGrowthSetup));
+  benchmarkReports["first touch by huge page hint"]
+      = setups::firstTouch::compare(benchmarkReports);
+  // The baselines run right before the co-scheduled setup, so both start from the same heap.
+  auto const baselines = runBenchmarks(singleSizeBaseline, geometricGrowthBaseline);
+  benchmarkReports[coScheduledSetup.name]
+      = coschedule::compareWithSolo(runBenchmark(coScheduledSetup), baselines);
+
+  // 24 bytes is not in the list and exercises the dynamic-extent fallback.
+  std::vector<std::size_t> sweepSizes(AllocationSizes::values.cbegin(),
+                                      AllocationSizes::values.cend());
+  sweepSizes.push_back(24U);
+  for (auto const allocationSize : sweepSizes) {
+    AllocationSizes::dispatch(allocationSize, [&](auto extent) {
+      auto setup
+          = setups::singleSizeMalloc::composeSweepSetup<decltype(extent)::value>(allocationSize);
+      benchmarkReports[setup.name] = runBenchmark(cache, setup);
+    });
+  }
+  for (std::size_t alignment = 16U; alignment <= BASE_PAGE_SIZE; alignment *= 2U) {
+    auto setup = setups::alignment::composeSweepSetup(alignment);
+    benchmarkReports[setup.name] = runBenchmark(cache, setup);
+  }
   auto report = composeReport(metadata, benchmarkReports);
   output(report);
   return EXIT_SUCCESS;
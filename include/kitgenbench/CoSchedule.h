@@ -0,0 +1,255 @@
+#pragma once
+#include <kitgenbench/SizeList.h>
+#include <kitgenbench/kitgenbench.h>
+#include <kitgenbench/setup.h>
+
+#include <algorithm>
+#include <alpaka/alpaka.hpp>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "nlohmann/json.hpp"
+
+namespace kitgenbench::coschedule {
+  /**
+   * @brief The recipe, logger or checker of whichever group a virtual thread belongs to.
+   *
+   * The alternatives must agree on the types returned from `next`, `call` and `check`,
+   * respectively, e.g. by using the same payload type.
+   */
+  template <typename... T> struct OneOf {
+    using Alternatives = std::variant<T...>;
+    Alternatives alternative;
+
+    ALPAKA_FN_ACC auto next(auto const& acc) {
+      return visitAlternatives([&acc](auto& recipe) { return recipe.next(acc); }, alternative);
+    }
+
+    ALPAKA_FN_ACC auto call(auto const& acc, auto func) {
+      return visitAlternatives([&acc, &func](auto& logger) { return logger.call(acc, func); },
+                               alternative);
+    }
+
+    ALPAKA_FN_ACC auto check(auto const& acc, auto const& result) {
+      return visitAlternatives(
+          [&acc, &result](auto& checker) { return checker.check(acc, result); }, alternative);
+    }
+  };
+
+  struct Recipes {
+    ALPAKA_FN_INLINE ALPAKA_FN_HOST_ACC static auto& of(auto& package) { return package.recipes; }
+  };
+
+  struct Loggers {
+    ALPAKA_FN_INLINE ALPAKA_FN_HOST_ACC static auto& of(auto& package) { return package.loggers; }
+  };
+
+  struct Checkers {
+    ALPAKA_FN_INLINE ALPAKA_FN_HOST_ACC static auto& of(auto& package) { return package.checkers; }
+  };
+
+  /**
+   * @brief Hands every virtual thread the recipe, logger or checker (as chosen by `TSelector`) of
+   * the group it belongs to.
+   *
+   * Each group's provider sees the thread indices counted from the start of its group, so it
+   * behaves exactly as if its group ran alone.
+   */
+  template <typename TSelector, typename... TPackage> struct PartitionedProvider {
+    static constexpr std::size_t numGroups = sizeof...(TPackage);
+    using Element = OneOf<std::remove_cvref_t<
+        decltype(TSelector::of(std::declval<TPackage&>()).load(std::uint32_t{}))>...>;
+
+    std::tuple<TPackage*...> packages{};
+    // Group `i` runs on the virtual threads from `ends[i - 1]` (or zero) up to `ends[i]`.
+    std::array<std::uint32_t, numGroups> ends{};
+
+    template <std::size_t TGroup> ALPAKA_FN_INLINE ALPAKA_FN_ACC auto begin() const {
+      if constexpr (TGroup == 0U) {
+        return std::uint32_t{0U};
+      } else {
+        return ends[TGroup - 1U];
+      }
+    }
+
+    template <std::size_t TGroup = 0U> ALPAKA_FN_ACC Element load(auto const threadIndex) {
+      if constexpr (TGroup + 1U < numGroups) {
+        if (threadIndex >= ends[TGroup]) {
+          return load<TGroup + 1U>(threadIndex);
+        }
+      }
+      return {typename Element::Alternatives(
+          std::in_place_index<TGroup>,
+          TSelector::of(*std::get<TGroup>(packages)).load(threadIndex - begin<TGroup>()))};
+    }
+
+    template <std::size_t TGroup = 0U>
+    ALPAKA_FN_ACC void store(auto const& acc, Element&& instance, auto const threadIndex) {
+      if constexpr (TGroup + 1U < numGroups) {
+        if (threadIndex >= ends[TGroup]) {
+          store<TGroup + 1U>(acc, std::move(instance), threadIndex);
+          return;
+        }
+      }
+      TSelector::of(*std::get<TGroup>(packages))
+          .store(acc, std::move(std::get<TGroup>(instance.alternative)),
+                 threadIndex - begin<TGroup>());
+    }
+  };
+
+  template <typename... TPackage> struct DevicePackage {
+    PartitionedProvider<Recipes, TPackage...> recipes{};
+    PartitionedProvider<Loggers, TPackage...> loggers{};
+    PartitionedProvider<Checkers, TPackage...> checkers{};
+  };
+
+  /**
+   * @brief Combines the instructions of several groups, so they run side by side in one launch.
+   *
+   * All groups are sent to the device as usual. Only a small package pointing to them is added on
+   * top.
+   */
+  template <typename TAcc, typename TDev, typename... TInstructions> struct InstructionDetails {
+    using Queue = alpaka::Queue<TAcc, alpaka::Blocking>;
+    using Package = DevicePackage<std::remove_pointer_t<
+        decltype(std::declval<TInstructions&>().sendTo(std::declval<TDev const&>(),
+                                                       std::declval<Queue&>()))>...>;
+    static constexpr std::size_t numGroups = sizeof...(TInstructions);
+
+    std::tuple<TInstructions...> groups;
+    std::array<std::string, numGroups> names{};
+    std::array<std::uint32_t, numGroups> ends{};
+    alpaka::Buf<TDev, Package, alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> packageBuffer;
+    Package hostPackage{};
+
+    auto sendTo(TDev const& device, auto& queue) {
+      auto packages = std::apply(
+          [&device, &queue](auto&... group) {
+            return std::make_tuple(group.sendTo(device, queue)...);
+          },
+          groups);
+      hostPackage = {{packages, ends}, {packages, ends}, {packages, ends}};
+      auto const platformHost = alpaka::PlatformCpu{};
+      auto const devHost = alpaka::getDevByIdx(platformHost, 0);
+      auto view = alpaka::createView(devHost, &hostPackage, 1U);
+      alpaka::memcpy(queue, packageBuffer, view);
+      return reinterpret_cast<Package*>(alpaka::getPtrNative(packageBuffer));
+    }
+
+    auto retrieveFrom(TDev const& device, auto& queue) {
+      std::apply([&device, &queue](auto&... group) { (group.retrieveFrom(device, queue), ...); },
+                 groups);
+    }
+
+    nlohmann::json generateReport() {
+      return reportGroups(std::make_index_sequence<numGroups>{});
+    }
+
+    template <std::size_t... TGroup> nlohmann::json reportGroups(std::index_sequence<TGroup...>) {
+      nlohmann::json report = nlohmann::json::object();
+      (
+          [&] {
+            auto& group = report["groups"][names[TGroup]];
+            group = std::get<TGroup>(groups).generateReport();
+            group["virtual threads"] = {TGroup == 0U ? 0U : ends[TGroup - 1U], ends[TGroup]};
+          }(),
+          ...);
+      return report;
+    }
+  };
+
+  /**
+   * @brief Composes a setup that runs the given setups at the same time, each on its own group of
+   * threads, so they compete for the same heap.
+   *
+   * Every group gets as many virtual threads as its setup would use on its own. If all setups
+   * emulate their threads via the element layer, the groups are concatenated there. Otherwise,
+   * they are concatenated block-wise, so they must agree on the number of threads per block and
+   * elements per thread. The execution details apart from the work division are taken from the
+   * first setup. Names of the setups must be distinct.
+   *
+   * The instructions of the setups are moved into the composed one. Copies of instructions share
+   * their device buffers, so the setups must not be run or co-scheduled elsewhere. To get a
+   * baseline for `compareWithSolo`, compose the same setups a second time and run those on their
+   * own.
+   */
+  template <typename TSetup, typename... TSetups>
+  auto composeSetup(std::string name, TSetup&& first, TSetups&&... others) {
+    static_assert(
+        not(std::is_lvalue_reference_v<TSetup> or ... or std::is_lvalue_reference_v<TSetups>),
+        "Co-scheduled setups take over the instructions of their groups, so pass setups that are "
+        "not used anywhere else via std::move.");
+    auto execution = first.execution;
+    using Acc = decltype(detail::AccOf{execution})::type;
+    using Dev = std::remove_cvref_t<decltype(execution.device)>;
+    using Dim = alpaka::Dim<Acc>;
+    using Idx = alpaka::Idx<Acc>;
+    using Vec = alpaka::Vec<Dim, Idx>;
+
+    auto const workdivs = std::array{first.execution.workdiv, others.execution.workdiv...};
+    std::array<std::uint32_t, workdivs.size()> ends{};
+    std::uint32_t end = 0U;
+    for (std::size_t i = 0U; i < workdivs.size(); ++i) {
+      end += static_cast<std::uint32_t>(getNumVirtualThreads(workdivs[i]));
+      ends[i] = end;
+    }
+
+    auto const isEmulated = [](auto const& workdiv) {
+      return alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(workdiv).prod() == 1;
+    };
+    if (std::ranges::all_of(workdivs, isEmulated)) {
+      auto elements = Vec::ones();
+      elements[Dim::value - 1U] = static_cast<Idx>(end);
+      execution.workdiv = {Vec::ones(), Vec::ones(), elements};
+    } else {
+      auto const blockThreads
+          = alpaka::getWorkDiv<alpaka::Block, alpaka::Threads>(execution.workdiv);
+      auto const threadElems = alpaka::getWorkDiv<alpaka::Thread, alpaka::Elems>(execution.workdiv);
+      Idx numBlocks = 0U;
+      for (auto const& workdiv : workdivs) {
+        if (not(alpaka::getWorkDiv<alpaka::Block, alpaka::Threads>(workdiv) == blockThreads)
+            or not(alpaka::getWorkDiv<alpaka::Thread, alpaka::Elems>(workdiv) == threadElems)) {
+          throw std::invalid_argument(
+              "Co-scheduled setups must agree on threads per block and elements per thread.");
+        }
+        numBlocks += alpaka::getWorkDiv<alpaka::Grid, alpaka::Blocks>(workdiv).prod();
+      }
+      auto blocks = Vec::ones();
+      blocks[Dim::value - 1U] = numBlocks;
+      execution.workdiv = {blocks, blockThreads, threadElems};
+    }
+
+    using Instructions
+        = InstructionDetails<Acc, Dev, std::remove_cvref_t<decltype(first.instructions)>,
+                             std::remove_cvref_t<decltype(others.instructions)>...>;
+    auto instructions = Instructions{
+        {std::move(first.instructions), std::move(others.instructions)...},
+        {first.name, others.name...},
+        ends,
+        alpaka::allocBuf<typename Instructions::Package, Idx>(execution.device, Idx{1U})};
+
+    nlohmann::json description{
+        {"what it does", "Runs several setups at the same time on disjoint groups of threads."}};
+    description["groups"][first.name] = first.description;
+    ((description["groups"][others.name] = others.description), ...);
+    return setup::composeSetup(std::move(name), execution, std::move(instructions), description);
+  }
+
+  /**
+   * @brief Puts every group's result next to the result of running the same setup on its own.
+   *
+   * @param report The report of a co-scheduled setup.
+   * @param soloReports The reports of the solo runs keyed by setup name, as returned by
+   * `runBenchmarks`. Groups without a solo run are left as they are.
+   * @return nlohmann::json The report with each group split into "co-scheduled" and "solo". The
+   * "slowdown" lists the ratio of all average times between the two. If the solo run used a
+   * different interleaving, there's an "error" instead.
+   */
+  nlohmann::json compareWithSolo(nlohmann::json report, nlohmann::json const& soloReports);
+}  // namespace kitgenbench::coschedule
@@ -3,6 +3,7 @@
 #include <alpaka/acc/Tag.hpp>
 #include <alpaka/core/Common.hpp>
 #include <chrono>
+#include <cstdint>
 
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
 #  include <cuda_runtime.h>
@@ -23,6 +24,13 @@ namespace kitgenbench {
                  std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
              / 1000000;
     }
+
+    // Nanoseconds on a clock that all threads share, so stamps can be compared across threads.
+    ALPAKA_FN_INLINE ALPAKA_FN_ACC static std::uint64_t timestamp() {
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                            std::chrono::steady_clock::now().time_since_epoch())
+                                            .count());
+    }
   };
 
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
@@ -35,6 +43,13 @@ namespace kitgenbench {
       return start <= end ? end - start
                           : std::numeric_limits<decltype(clock64())>::max() - start + end;
     }
+
+    // Unlike `clock64`, the global timer is the same on all multiprocessors.
+    ALPAKA_FN_INLINE __device__ static std::uint64_t timestamp() {
+      std::uint64_t time;
+      asm volatile("mov.u64 %0, %%globaltimer;" : "=l"(time));
+      return time;
+    }
   };
 
 #endif
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace kitgenbench {
+  /**
+   * @brief Measures the energy consumed by the CPU packages and DRAM via the RAPL counters exposed
+   * by Linux's powercap framework.
+   *
+   * The counters wrap around at `max_energy_range_uj`, which is accounted for as long as they don't
+   * wrap more than once between `start` and `stop`. Reading them typically requires root privileges
+   * on recent kernels. If anything goes wrong, the report contains an error instead of numbers.
+   */
+  struct EnergyProbe {
+    struct Zone {
+      std::string id{};
+      std::string name{};
+      std::filesystem::path counter{};
+      std::uint64_t maxEnergy{};
+      std::uint64_t startEnergy{};
+    };
+
+    std::filesystem::path root{};
+    std::vector<Zone> zones{};
+    std::string error{};
+
+    /**
+     * @brief Finds all package and DRAM zones below the given powercap directory.
+     *
+     * @param root The sysfs directory to look in, configurable for testing.
+     */
+    explicit EnergyProbe(std::filesystem::path root = "/sys/class/powercap");
+
+    void start();
+
+    /**
+     * @brief Reads the counters again and reports the energy consumed since `start`.
+     *
+     * @return nlohmann::json A JSON object with the energy per zone and the totals in joules.
+     */
+    nlohmann::json stop();
+  };
+
+  /**
+   * @brief Adds the average energy per action to an energy report.
+   *
+   * This is the energy of the whole kernel divided by the total number of actions, so it includes
+   * everything else the kernel does, too.
+   *
+   * @param energy A report as returned by `EnergyProbe::stop`.
+   * @param report The report of the benchmark. Entries like "allocation count" and "deallocation
+   * count" in its "logs" (or in the "logs" of all its "groups" if it was co-scheduled) are summed up
+   * to get the number of actions performed.
+   */
+  void addEnergyPerAction(nlohmann::json& energy, nlohmann::json const& report);
+}  // namespace kitgenbench
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <alpaka/atomic/Traits.hpp>
+#include <alpaka/core/Common.hpp>
+#include <alpaka/mem/fence/Traits.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace kitgenbench {
+  /**
+   * @brief Bounded lock-free multi-producer multi-consumer queue for handing data from one thread
+   * to another on the device.
+   *
+   * This is the well-known algorithm by Dmitry Vyukov: Every cell carries a sequence number telling
+   * whether it is ready to be written to or read from in the current round. Pushing and popping
+   * never block, they just fail if the queue is full or empty, respectively. So, threads can't
+   * deadlock waiting on each other even if they are in the same warp.
+   *
+   * The queue doesn't own its cells. They must be initialised via `initCells` on the host and
+   * copied to the device alongside the queue.
+   */
+  template <typename T> struct HandoffQueue {
+    struct Cell {
+      std::uint32_t sequence{};
+      T data{};
+    };
+
+    Cell* cells{nullptr};
+    std::uint32_t capacity{0U};
+    std::uint32_t enqueuePosition{0U};
+    std::uint32_t dequeuePosition{0U};
+
+    static std::vector<Cell> initCells(std::uint32_t const capacity) {
+      std::vector<Cell> result(capacity);
+      for (std::uint32_t i = 0U; i < capacity; ++i) {
+        result[i].sequence = i;
+      }
+      return result;
+    }
+
+    ALPAKA_FN_ACC auto tryPush(auto const& acc, T const& value) -> bool {
+      auto position = alpaka::atomicAdd(acc, &enqueuePosition, 0U);
+      Cell* cell{nullptr};
+      while (true) {
+        cell = &cells[position % capacity];
+        auto const sequence = alpaka::atomicAdd(acc, &cell->sequence, 0U);
+        auto const difference = static_cast<std::int32_t>(sequence - position);
+        if (difference == 0) {
+          auto const old = alpaka::atomicCas(acc, &enqueuePosition, position, position + 1U);
+          if (old == position) {
+            break;
+          }
+          position = old;
+        } else if (difference < 0) {
+          return false;
+        } else {
+          position = alpaka::atomicAdd(acc, &enqueuePosition, 0U);
+        }
+      }
+      cell->data = value;
+      alpaka::mem_fence(acc, alpaka::memory_scope::Device{});
+      alpaka::atomicExch(acc, &cell->sequence, position + 1U);
+      return true;
+    }
+
+    ALPAKA_FN_ACC auto tryPop(auto const& acc, T& value) -> bool {
+      auto position = alpaka::atomicAdd(acc, &dequeuePosition, 0U);
+      Cell* cell{nullptr};
+      while (true) {
+        cell = &cells[position % capacity];
+        auto const sequence = alpaka::atomicAdd(acc, &cell->sequence, 0U);
+        auto const difference = static_cast<std::int32_t>(sequence - (position + 1U));
+        if (difference == 0) {
+          auto const old = alpaka::atomicCas(acc, &dequeuePosition, position, position + 1U);
+          if (old == position) {
+            break;
+          }
+          position = old;
+        } else if (difference < 0) {
+          return false;
+        } else {
+          position = alpaka::atomicAdd(acc, &dequeuePosition, 0U);
+        }
+      }
+      alpaka::mem_fence(acc, alpaka::memory_scope::Device{});
+      value = cell->data;
+      alpaka::atomicExch(acc, &cell->sequence, position + capacity);
+      return true;
+    }
+  };
+}  // namespace kitgenbench
@@ -0,0 +1,29 @@
+#pragma once
+#include <filesystem>
+
+#include "nlohmann/json.hpp"
+
+namespace kitgenbench {
+  /**
+   * @brief Counts the page faults of the whole process via `getrusage`.
+   *
+   * This includes faults from other host threads, e.g. those of alpaka's CPU backends. Device
+   * memory is not covered.
+   */
+  struct PageFaultProbe {
+    long minorFaults{0};
+    long majorFaults{0};
+    // Where the system-wide transparent huge page setting is read from, configurable for testing.
+    std::filesystem::path hugePageSetting{"/sys/kernel/mm/transparent_hugepage/enabled"};
+
+    void start();
+
+    /**
+     * @brief Reports the page faults since `start`.
+     *
+     * @return nlohmann::json A JSON object with the number of minor and major faults as well as
+     * the system's transparent huge page mode, which determines what `madvise` hints achieve.
+     */
+    nlohmann::json stop() const;
+  };
+}  // namespace kitgenbench
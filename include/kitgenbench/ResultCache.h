@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+namespace kitgenbench {
+  /**
+   * @brief Identifies the binary currently running, so results from a rebuilt binary are not
+   * reused.
+   *
+   * @return std::string The GNU build ID of the executable or, if it has none, a hash of its
+   * content.
+   */
+  std::string getBuildId();
+
+  /**
+   * @brief Persists benchmark results on disk, addressed by a hash of everything that determines
+   * them.
+   *
+   * Each result is stored in its own file named after the key. The file also contains everything
+   * the key was computed from and a result is only considered valid if this matches exactly. An
+   * empty directory disables the cache, i.e. nothing is ever found or stored.
+   */
+  struct ResultCache {
+    std::filesystem::path directory{};
+    // Build ID and host metadata are the same for all setups, so we compute them only once.
+    nlohmann::json environment{};
+    std::size_t hits{0U};
+    std::size_t misses{0U};
+
+    /**
+     * @param directory Where to store the results. It is created if necessary.
+     * @param metadata As returned by `gatherMetadata`. Only the parts describing the hardware
+     * are taken into account, so things like the start time don't invalidate the cache.
+     * @param buildId Identifies the binary that produced the results.
+     */
+    ResultCache(std::filesystem::path directory, nlohmann::json const& metadata,
+                std::string buildId = getBuildId());
+
+    /**
+     * @brief Computes the key for a setup.
+     *
+     * @param identity Everything specific to the setup, e.g. its name, description and
+     * parameters.
+     */
+    std::string key(nlohmann::json const& identity) const;
+
+    std::optional<nlohmann::json> load(std::string const& key, nlohmann::json const& identity);
+    void store(std::string const& key, nlohmann::json const& identity,
+               nlohmann::json const& result) const;
+  };
+}  // namespace kitgenbench
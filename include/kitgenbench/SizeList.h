@@ -0,0 +1,106 @@
+#pragma once
+
+#include <alpaka/core/Common.hpp>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace kitgenbench {
+  /**
+   * @brief Calls `func` with the alternative currently held by `variant`.
+   *
+   * Unlike `std::visit`, this compiles to a plain chain of branches, so it's usable in device code.
+   * All alternatives must yield the same return type.
+   */
+  template <std::size_t TIndex = 0U, typename TFunc, typename... T>
+  ALPAKA_FN_INLINE ALPAKA_FN_HOST_ACC constexpr auto visitAlternatives(
+      TFunc&& func, std::variant<T...> const& variant) {
+    if constexpr (TIndex + 1 == sizeof...(T)) {
+      return func(std::get<TIndex>(variant));
+    } else {
+      if (variant.index() == TIndex) {
+        return func(std::get<TIndex>(variant));
+      }
+      return visitAlternatives<TIndex + 1>(std::forward<TFunc>(func), variant);
+    }
+  }
+
+  // Same for a mutable variant, so `func` can modify the alternative.
+  template <std::size_t TIndex = 0U, typename TFunc, typename... T>
+  ALPAKA_FN_INLINE ALPAKA_FN_HOST_ACC constexpr auto visitAlternatives(TFunc&& func,
+                                                                      std::variant<T...>& variant) {
+    if constexpr (TIndex + 1 == sizeof...(T)) {
+      return func(std::get<TIndex>(variant));
+    } else {
+      if (variant.index() == TIndex) {
+        return func(std::get<TIndex>(variant));
+      }
+      return visitAlternatives<TIndex + 1>(std::forward<TFunc>(func), variant);
+    }
+  }
+
+  /**
+   * @brief Forgets about the compile-time extent of whichever span is held by the variant.
+   */
+  template <typename T, std::size_t... TExtents>
+  ALPAKA_FN_INLINE ALPAKA_FN_HOST_ACC constexpr auto asDynamicSpan(
+      std::variant<std::span<T, TExtents>...> const& spans) -> std::span<T> {
+    return visitAlternatives([](auto const& range) { return std::span<T>(range); }, spans);
+  }
+
+  namespace detail {
+    template <typename TFunc> auto dispatchSize(std::size_t const, TFunc&& func) {
+      return func(std::integral_constant<std::size_t, std::dynamic_extent>{});
+    }
+
+    template <std::size_t TFirst, std::size_t... TRest, typename TFunc>
+    auto dispatchSize(std::size_t const size, TFunc&& func) {
+      if (size == TFirst) {
+        return func(std::integral_constant<std::size_t, TFirst>{});
+      }
+      return dispatchSize<TRest...>(size, std::forward<TFunc>(func));
+    }
+  }  // namespace detail
+
+  /**
+   * @brief A compile-time list of sizes, typically allocation sizes.
+   *
+   * Code paths for the listed sizes can be instantiated with fixed extents while arbitrary sizes
+   * fall back to `std::dynamic_extent`.
+   */
+  template <std::size_t... TSizes> struct SizeList {
+    static constexpr std::array<std::size_t, sizeof...(TSizes)> values{TSizes...};
+
+    // Fixed-extent spans for all listed sizes plus a dynamic-extent one for everything else.
+    template <typename T> using Spans = std::variant<std::span<T, TSizes>..., std::span<T>>;
+
+    static constexpr bool contains(std::size_t const size) { return ((size == TSizes) or ...); }
+
+    /**
+     * @brief Calls `func` with `std::integral_constant<std::size_t, size>` if `size` is listed and
+     * with `std::integral_constant<std::size_t, std::dynamic_extent>` otherwise.
+     */
+    template <typename TFunc> static auto dispatch(std::size_t const size, TFunc&& func) {
+      return detail::dispatchSize<TSizes...>(size, std::forward<TFunc>(func));
+    }
+  };
+
+  namespace detail {
+    constexpr std::size_t log2(std::size_t const value) {
+      return value <= 1U ? 0U : 1U + log2(value / 2U);
+    }
+
+    template <std::size_t TMin, std::size_t... TIndices>
+    auto powersOfTwo(std::index_sequence<TIndices...>) -> SizeList<(TMin << TIndices)...>;
+  }  // namespace detail
+
+  /**
+   * @brief All powers of two from `TMin` to `TMax` (both included).
+   */
+  template <std::size_t TMin, std::size_t TMax> using PowersOfTwo
+      = decltype(detail::powersOfTwo<TMin>(
+          std::make_index_sequence<detail::log2(TMax / TMin) + 1>{}));
+}  // namespace kitgenbench
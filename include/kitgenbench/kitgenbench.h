@@ -1,23 +1,87 @@
 #pragma once
+#include <kitgenbench/EnergyProbe.h>
+#include <kitgenbench/PageFaultProbe.h>
+#include <kitgenbench/ResultCache.h>
 #include <kitgenbench/setup.h>
 
 #include <alpaka/acc/Traits.hpp>
 #include <alpaka/alpaka.hpp>
 #include <alpaka/dev/Traits.hpp>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <ranges>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 
 #include "alpaka/queue/Properties.hpp"
 
 namespace kitgenbench {
 
+  /**
+   * @brief Order in which the virtual threads of the element layer execute their recipes.
+   *
+   * By default, every virtual thread runs its recipe to completion before the next one starts.
+   * This allocates in an order no parallel run would ever produce. The other modes step all
+   * virtual threads of a thread one action at a time, either round-robin or in a random order
+   * that's reproducible via the seed. This only makes a difference if there is more than one
+   * element per thread, e.g., in a serial run.
+   */
+  struct Interleaving {
+    enum class Mode { none, roundRobin, random };
+    Mode mode{Mode::none};
+    std::uint64_t seed{0U};
+
+    nlohmann::json generateReport() const {
+      switch (mode) {
+        case Mode::roundRobin:
+          return {{"mode", "round robin"}};
+        case Mode::random:
+          return {{"mode", "random"}, {"seed", seed}};
+        default:
+          return {{"mode", "none"}};
+      }
+    }
+  };
+
   template <typename TAcc, typename TDev> struct ExecutionDetails {
     alpaka::WorkDivMembers<alpaka::Dim<TAcc>, alpaka::Idx<TAcc>> workdiv{};
     TDev device{};
+    Interleaving interleaving{};
+    // If set, the energy consumed during the kernel execution is measured and reported.
+    std::optional<EnergyProbe> energyProbe{};
+    // If set, the page faults during the kernel execution are counted and reported.
+    std::optional<PageFaultProbe> pageFaultProbe{};
   };
 
+  /**
+   * @brief Number of threads a recipe is run on including those emulated via the element layer.
+   */
+  auto getNumVirtualThreads(auto const& workdiv) {
+    return (alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(workdiv)
+            * alpaka::getWorkDiv<alpaka::Thread, alpaka::Elems>(workdiv))
+        .prod();
+  }
+
+  /**
+   * @brief Performs one action of the recipe and checks it.
+   *
+   * @return bool Whether the recipe is exhausted.
+   */
+  ALPAKA_FN_INLINE ALPAKA_FN_ACC bool step(auto const& acc, auto& recipe, auto& logger,
+                                           auto& checker) {
+    auto result
+        = logger.call(acc, [&recipe](const auto& acc) mutable { return recipe.next(acc); });
+    logger.call(acc, [&checker, &result](const auto& acc) mutable {
+      return checker.check(acc, result);
+    });
+    return (std::get<0>(result) == Actions::STOP);
+  }
+
   struct BenchmarkKernel {
     template <typename TAcc>
     ALPAKA_FN_ACC auto operator()(TAcc const& acc, auto* instructions) const -> void {
@@ -26,10 +90,12 @@ namespace kitgenbench {
       auto const elementsPerThread = alpaka::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc);
 
       // This outmost loop ensures that a serial run with element layer set to the number of threads
-      // does the same thing as a parallel run.
+      // does the same thing as a parallel run. Every thread handles a contiguous range of virtual
+      // threads.
       for (auto const i : std::ranges::iota_view(0U, elementsPerThread.x())) {
         auto const linearizedGlobalThreadIdx
-            = alpaka::mapIdx<1u>(globalThreadIdx, globalThreadExtent).x() + i;
+            = alpaka::mapIdx<1u>(globalThreadIdx, globalThreadExtent).x() * elementsPerThread.x()
+              + i;
         taskForOneThread(acc, linearizedGlobalThreadIdx, instructions);
       }
     }
@@ -43,12 +109,7 @@ namespace kitgenbench {
 
       bool recipeExhausted = false;
       while (not recipeExhausted) {
-        auto result = myLogger.call(
-            acc, [&myRecipe](const auto& acc) mutable { return myRecipe.next(acc); });
-        myLogger.call(acc, [&myChecker, &result](const auto& acc) mutable {
-          return myChecker.check(acc, result);
-        });
-        recipeExhausted = (std::get<0>(result) == Actions::STOP);
+        recipeExhausted = step(acc, myRecipe, myLogger, myChecker);
       }
 
       // Put our local copy back from where we got it.
@@ -58,6 +119,95 @@ namespace kitgenbench {
     }
   };
 
+  /**
+   * @brief State of all virtual threads that are in flight at the same time, stored as one array
+   * per kind of state.
+   */
+  template <typename TRecipe, typename TLogger, typename TChecker> struct ThreadStateArena {
+    TRecipe* recipes{nullptr};
+    TLogger* loggers{nullptr};
+    TChecker* checkers{nullptr};
+    // Indices of the virtual threads that are not yet done.
+    std::uint32_t* pending{nullptr};
+  };
+
+  struct InterleavedBenchmarkKernel {
+    template <typename TAcc>
+    ALPAKA_FN_ACC auto operator()(TAcc const& acc, auto* instructions, auto arena,
+                                  Interleaving const interleaving) const -> void {
+      auto const globalThreadIdx = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc);
+      auto const globalThreadExtent = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc);
+      auto const elementsPerThread = alpaka::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc).x();
+      auto const linearizedThreadIdx = alpaka::mapIdx<1u>(globalThreadIdx, globalThreadExtent).x();
+      // Same numbering as in `BenchmarkKernel`.
+      auto const virtualThreadIdx = [linearizedThreadIdx, elementsPerThread](auto const i) {
+        return linearizedThreadIdx * elementsPerThread + i;
+      };
+
+      auto const offset = linearizedThreadIdx * elementsPerThread;
+      auto* recipes = arena.recipes + offset;
+      auto* loggers = arena.loggers + offset;
+      auto* checkers = arena.checkers + offset;
+      auto* pending = arena.pending + offset;
+
+      for (auto const i : std::ranges::iota_view(0U, elementsPerThread)) {
+        new (&recipes[i]) std::remove_cvref_t<decltype(*recipes)>(
+            instructions->recipes.load(virtualThreadIdx(i)));
+        new (&loggers[i]) std::remove_cvref_t<decltype(*loggers)>(
+            instructions->loggers.load(virtualThreadIdx(i)));
+        new (&checkers[i]) std::remove_cvref_t<decltype(*checkers)>(
+            instructions->checkers.load(virtualThreadIdx(i)));
+        pending[i] = i;
+      }
+
+      auto finish = [&](auto const i) {
+        instructions->recipes.store(acc, std::move(recipes[i]), virtualThreadIdx(i));
+        instructions->loggers.store(acc, std::move(loggers[i]), virtualThreadIdx(i));
+        instructions->checkers.store(acc, std::move(checkers[i]), virtualThreadIdx(i));
+        std::destroy_at(&recipes[i]);
+        std::destroy_at(&loggers[i]);
+        std::destroy_at(&checkers[i]);
+      };
+
+      auto numPending = elementsPerThread;
+      if (interleaving.mode == Interleaving::Mode::random) {
+        auto random = SplitMix64{interleaving.seed ^ linearizedThreadIdx};
+        while (numPending > 0U) {
+          auto const k = static_cast<decltype(numPending)>(random() % numPending);
+          auto const i = pending[k];
+          if (step(acc, recipes[i], loggers[i], checkers[i])) {
+            finish(i);
+            pending[k] = pending[--numPending];
+          }
+        }
+      } else {
+        while (numPending > 0U) {
+          decltype(numPending) numKept = 0U;
+          for (auto const k : std::ranges::iota_view(decltype(numPending){0U}, numPending)) {
+            auto const i = pending[k];
+            if (step(acc, recipes[i], loggers[i], checkers[i])) {
+              finish(i);
+            } else {
+              pending[numKept++] = i;
+            }
+          }
+          numPending = numKept;
+        }
+      }
+    }
+
+    // Small and fast generator that's good enough for picking the next thread to step.
+    struct SplitMix64 {
+      std::uint64_t state;
+      ALPAKA_FN_INLINE ALPAKA_FN_ACC auto operator()() -> std::uint64_t {
+        auto z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31U);
+      }
+    };
+  };
+
   namespace detail {
     template <template <typename, typename> typename TExecutionDetails, typename TAcc,
               typename TDev>
@@ -65,16 +215,75 @@ namespace kitgenbench {
       TExecutionDetails<TAcc, TDev> execution;
       using type = TAcc;
     };
+
+    /**
+     * @brief Owns the memory behind a `ThreadStateArena`.
+     *
+     * It's allocated before the instructions are sent and the probes are started, so it neither
+     * shows up in the measurements nor changes the layout of the heap under test.
+     */
+    template <typename TAcc, typename TDev, typename TDevicePackage> struct ThreadStateBuffers {
+      using Idx = alpaka::Idx<TAcc>;
+      using Recipe = std::remove_cvref_t<
+          decltype(std::declval<TDevicePackage&>().recipes.load(Idx{}))>;
+      using Logger = std::remove_cvref_t<
+          decltype(std::declval<TDevicePackage&>().loggers.load(Idx{}))>;
+      using Checker = std::remove_cvref_t<
+          decltype(std::declval<TDevicePackage&>().checkers.load(Idx{}))>;
+      template <typename T> using Buf = alpaka::Buf<TDev, T, alpaka::Dim<TAcc>, Idx>;
+
+      Buf<Recipe> recipes;
+      Buf<Logger> loggers;
+      Buf<Checker> checkers;
+      Buf<std::uint32_t> pending;
+
+      ThreadStateBuffers(TDev const& device, Idx const numVirtualThreads)
+          : recipes(alpaka::allocBuf<Recipe, Idx>(device, numVirtualThreads)),
+            loggers(alpaka::allocBuf<Logger, Idx>(device, numVirtualThreads)),
+            checkers(alpaka::allocBuf<Checker, Idx>(device, numVirtualThreads)),
+            pending(alpaka::allocBuf<std::uint32_t, Idx>(device, numVirtualThreads)) {}
+
+      auto arena() {
+        return ThreadStateArena<Recipe, Logger, Checker>{
+            alpaka::getPtrNative(recipes), alpaka::getPtrNative(loggers),
+            alpaka::getPtrNative(checkers), alpaka::getPtrNative(pending)};
+      }
+    };
   }  // namespace detail
 
   nlohmann::json runBenchmark(auto& setup) {
     auto start = std::chrono::high_resolution_clock::now();
     using Acc = decltype(detail::AccOf{setup.execution})::type;
+    using Dev = std::remove_cvref_t<decltype(setup.execution.device)>;
     auto queue = alpaka::Queue<Acc, alpaka::Blocking>(setup.execution.device);
 
-    alpaka::exec<Acc>(queue, setup.execution.workdiv, BenchmarkKernel{},
-                      setup.instructions.sendTo(setup.execution.device, queue));
+    using DevicePackage = std::remove_pointer_t<decltype(setup.instructions.sendTo(
+        setup.execution.device, queue))>;
+    std::optional<detail::ThreadStateBuffers<Acc, Dev, DevicePackage>> threadState{};
+    if (setup.execution.interleaving.mode != Interleaving::Mode::none) {
+      auto const numVirtualThreads
+          = static_cast<alpaka::Idx<Acc>>(getNumVirtualThreads(setup.execution.workdiv));
+      threadState.emplace(setup.execution.device, numVirtualThreads);
+    }
+    auto* instructions = setup.instructions.sendTo(setup.execution.device, queue);
     alpaka::wait(queue);
+    auto& energyProbe = setup.execution.energyProbe;
+    auto& pageFaultProbe = setup.execution.pageFaultProbe;
+    if (pageFaultProbe) {
+      pageFaultProbe->start();
+    }
+    if (energyProbe) {
+      energyProbe->start();
+    }
+    if (threadState) {
+      alpaka::exec<Acc>(queue, setup.execution.workdiv, InterleavedBenchmarkKernel{}, instructions,
+                        threadState->arena(), setup.execution.interleaving);
+    } else {
+      alpaka::exec<Acc>(queue, setup.execution.workdiv, BenchmarkKernel{}, instructions);
+    }
+    alpaka::wait(queue);
+    auto energy = energyProbe ? energyProbe->stop() : nlohmann::json{};
+    auto pageFaults = pageFaultProbe ? pageFaultProbe->stop() : nlohmann::json{};
     setup.instructions.retrieveFrom(setup.execution.device, queue);
     alpaka::wait(queue);
 
@@ -84,8 +293,16 @@ namespace kitgenbench {
                              {"description", setup.description},
                              {"accelerator", alpaka::getAccName<Acc>()},
                              {"device", alpaka::getName(setup.execution.device)},
-                             {"workdiv", (std::ostringstream{} << setup.execution.workdiv).str()}};
+                             {"workdiv", (std::ostringstream{} << setup.execution.workdiv).str()},
+                             {"interleaving", setup.execution.interleaving.generateReport()}};
     result.merge_patch(setup.instructions.generateReport());
+    if (energyProbe) {
+      addEnergyPerAction(energy, result);
+      result["energy"] = energy;
+    }
+    if (pageFaultProbe) {
+      result["page faults"] = pageFaults;
+    }
     return result;
   };
 
@@ -99,6 +316,61 @@ namespace kitgenbench {
     return finalReport;
   };
 
+  namespace detail {
+    /**
+     * @brief Everything about a setup that determines its result, apart from the binary and the
+     * host it runs on.
+     *
+     * Instructions may provide a `parameters()` member returning JSON to contribute recipe
+     * parameters that are not part of the description.
+     */
+    nlohmann::json identify(auto const& setup) {
+      using Acc = decltype(detail::AccOf{setup.execution})::type;
+      nlohmann::json parameters
+          = {{"accelerator", alpaka::getAccName<Acc>()},
+             {"device", alpaka::getName(setup.execution.device)},
+             {"workdiv", (std::ostringstream{} << setup.execution.workdiv).str()},
+             {"interleaving", setup.execution.interleaving.generateReport()},
+             {"energy probe", setup.execution.energyProbe.has_value()},
+             {"page fault probe", setup.execution.pageFaultProbe.has_value()}};
+      if constexpr (requires { setup.instructions.parameters(); }) {
+        parameters["instructions"] = setup.instructions.parameters();
+      }
+      return {{"name", setup.name}, {"description", setup.description}, {"parameters", parameters}};
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Like `runBenchmark` but reuses the result from `cache` if the very same setup was run
+   * before. Otherwise, the setup is run and its result stored.
+   */
+  nlohmann::json runBenchmark(ResultCache& cache, auto& setup) {
+    auto const identity = detail::identify(setup);
+    auto const key = cache.key(identity);
+    if (auto cached = cache.load(key, identity)) {
+      return *cached;
+    }
+    auto result = runBenchmark(setup);
+    cache.store(key, identity, result);
+    return result;
+  };
+
+  /**
+   * @brief Like `runBenchmarks` but only runs setups that are not found in `cache`.
+   */
+  template <typename... TSetup>
+  nlohmann::json runBenchmarks(ResultCache& cache, TSetup&... setup) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto const hitsBefore = cache.hits;
+    auto finalReport = nlohmann::json::object();
+    (finalReport.push_back({setup.name, runBenchmark(cache, setup)}), ...);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    finalReport["total runtime [ms]"] = duration;
+    finalReport["setups from cache"] = cache.hits - hitsBefore;
+    return finalReport;
+  };
+
   /**
    * @brief Gathers metadata about the system, including start time, hostname, username, and CPU
    * information.
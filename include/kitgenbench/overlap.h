@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace kitgenbench::overlap {
+  /**
+   * @brief An allocation or deallocation as recorded on the device during a run.
+   *
+   * The stamp is read from a device-wide timer after the action has returned. Different threads
+   * may read the same value, so stamps only order events of different threads if they differ.
+   * Within a thread, `sequence` numbers the events. An allocation is guaranteed to be alive between
+   * its own stamp and the last stamp its thread recorded before freeing it. The latter is
+   * `previousStamp` of the deallocation event.
+   */
+  struct Event {
+    std::uintptr_t begin{};
+    std::uintptr_t end{};
+    std::uint64_t stamp{};
+    std::uint64_t previousStamp{};
+    std::uint32_t thread{};
+    std::uint32_t sequence{};
+    bool isFree{false};
+  };
+
+  /**
+   * @brief An address range together with the stamps between which it was certainly alive.
+   *
+   * For comparing with allocations of the same thread, the same interval is given in terms of
+   * that thread's event sequence.
+   */
+  struct Allocation {
+    std::uintptr_t begin{};
+    std::uintptr_t end{};
+    std::uint64_t aliveFrom{};
+    std::uint64_t aliveUntil{std::numeric_limits<std::uint64_t>::max()};
+    std::uint32_t thread{};
+    std::uint32_t aliveFromSequence{};
+    std::uint32_t aliveUntilSequence{std::numeric_limits<std::uint32_t>::max()};
+  };
+
+  /**
+   * @brief Pairs every deallocation with the preceding allocation of the same address on the same
+   * thread.
+   *
+   * @param events The recorded events in any order.
+   * @param unmatched Incremented for every deallocation without matching allocation.
+   * @return std::vector<Allocation> One entry per allocation. Allocations that were never freed
+   * stay alive until the end.
+   */
+  std::vector<Allocation> pairEvents(std::vector<Event> events, std::size_t& unmatched);
+
+  /**
+   * @brief Counts pairs of allocations that overlap in memory while both being alive.
+   *
+   * The allocations are sorted by address and swept, both in parallel on the host.
+   *
+   * @param allocations The allocations to check. Their order is not preserved.
+   * @param numWorkers Number of host threads to use, zero meaning all available ones.
+   * @return nlohmann::json A JSON object containing the number of overlaps and a few examples.
+   */
+  nlohmann::json findOverlaps(std::vector<Allocation>& allocations, unsigned numWorkers = 0U);
+}  // namespace kitgenbench::overlap
@@ -11,6 +11,11 @@ namespace kitgenbench::Actions {
   // setups. Library-defined actions have negative values, user-defined positive ones.
   static constexpr int STOP = -1;
   static constexpr int CHECK = -2;
+  // Allocation functions beyond plain malloc and free, which are common enough for the library to
+  // define them once for all users.
+  static constexpr int REALLOC = -3;
+  static constexpr int CALLOC = -4;
+  static constexpr int ALIGNED_ALLOC = -5;
 }  // namespace kitgenbench::Actions
 
 namespace kitgenbench::setup {
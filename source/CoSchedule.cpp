@@ -0,0 +1,50 @@
+#include <kitgenbench/CoSchedule.h>
+
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace kitgenbench::coschedule {
+  namespace {
+    // Compares all average times that both loggers report.
+    nlohmann::json slowdownOf(nlohmann::json const& coScheduled, nlohmann::json const& solo) {
+      nlohmann::json slowdown = nlohmann::json::object();
+      if (not coScheduled.is_object() or not solo.is_object()) {
+        return slowdown;
+      }
+      for (auto const& [key, value] : coScheduled.items()) {
+        if (key.find("average time") == std::string::npos or not value.is_number()) {
+          continue;
+        }
+        auto const baseline = solo.find(key);
+        if (baseline != solo.end() and baseline->is_number() and baseline->get<double>() > 0.0) {
+          slowdown[key] = value.get<double>() / baseline->get<double>();
+        }
+      }
+      return slowdown;
+    }
+  }  // namespace
+
+  nlohmann::json compareWithSolo(nlohmann::json report, nlohmann::json const& soloReports) {
+    if (not report.contains("groups")) {
+      return report;
+    }
+    auto const interleaving = report.value("interleaving", nlohmann::json{});
+    for (auto& [name, group] : report["groups"].items()) {
+      if (not soloReports.contains(name)) {
+        continue;
+      }
+      auto const& solo = soloReports[name];
+      // A different order of the virtual threads changes the timings on its own.
+      if (solo.value("interleaving", nlohmann::json{}) != interleaving) {
+        group = {{"co-scheduled", group},
+                 {"solo", solo},
+                 {"error", "The solo run used a different interleaving."}};
+        continue;
+      }
+      auto const slowdown = slowdownOf(group.value("logs", nlohmann::json{}),
+                                       solo.value("logs", nlohmann::json{}));
+      group = {{"co-scheduled", group}, {"solo", solo}, {"slowdown", slowdown}};
+    }
+    return report;
+  }
+}  // namespace kitgenbench::coschedule
@@ -0,0 +1,134 @@
+#include <kitgenbench/EnergyProbe.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+
+namespace kitgenbench {
+  namespace {
+    // Actions counted by the loggers, as named in their reports.
+    constexpr std::array actions{"allocation",        "deallocation",       "remote deallocation",
+                                 "reallocation",      "zeroed allocation", "aligned allocation"};
+
+    std::optional<std::string> readLine(std::filesystem::path const& file) {
+      std::ifstream stream(file);
+      std::string line;
+      if (not std::getline(stream, line)) {
+        return std::nullopt;
+      }
+      return line;
+    }
+
+    std::optional<std::uint64_t> readCounter(std::filesystem::path const& file) {
+      auto line = readLine(file);
+      if (not line) {
+        return std::nullopt;
+      }
+      try {
+        return std::stoull(*line);
+      } catch (std::exception const&) {
+        return std::nullopt;
+      }
+    }
+
+    bool isMeasured(std::string const& name) {
+      return name.starts_with("package-") or name == "dram";
+    }
+  }  // namespace
+
+  EnergyProbe::EnergyProbe(std::filesystem::path root) : root(std::move(root)) {
+    std::error_code errorCode{};
+    // All zones are listed at the top level. The MMIO interface exposes the same package counters
+    // once more, so we skip it to not count them twice.
+    for (auto const& entry : std::filesystem::directory_iterator(this->root, errorCode)) {
+      auto const id = entry.path().filename().string();
+      if (not id.starts_with("intel-rapl:")) {
+        continue;
+      }
+      auto name = readLine(entry.path() / "name");
+      auto maxEnergy = readCounter(entry.path() / "max_energy_range_uj");
+      if (name and maxEnergy and isMeasured(*name)) {
+        zones.push_back({id, *name, entry.path() / "energy_uj", *maxEnergy});
+      }
+    }
+    if (errorCode) {
+      error = "Cannot read " + this->root.string() + ": " + errorCode.message();
+    } else if (zones.empty()) {
+      error = "No RAPL package or DRAM zones found in " + this->root.string();
+    }
+    std::ranges::sort(zones, {}, &Zone::id);
+  }
+
+  void EnergyProbe::start() {
+    for (auto& zone : zones) {
+      auto energy = readCounter(zone.counter);
+      if (not energy) {
+        error = "Cannot read " + zone.counter.string();
+        return;
+      }
+      zone.startEnergy = *energy;
+    }
+  }
+
+  nlohmann::json EnergyProbe::stop() {
+    if (not error.empty()) {
+      return {{"error", error}};
+    }
+    auto report = nlohmann::json::object();
+    double packageEnergy = 0.0;
+    double dramEnergy = 0.0;
+    for (auto const& zone : zones) {
+      auto energy = readCounter(zone.counter);
+      if (not energy) {
+        return {{"error", "Cannot read " + zone.counter.string()}};
+      }
+      auto const consumed = *energy >= zone.startEnergy
+                                ? *energy - zone.startEnergy
+                                : zone.maxEnergy - zone.startEnergy + *energy;
+      auto const joules = static_cast<double>(consumed) * 1e-6;
+      report["zones"][zone.id] = {{"name", zone.name}, {"energy [J]", joules}};
+      (zone.name == "dram" ? dramEnergy : packageEnergy) += joules;
+    }
+    report["package energy [J]"] = packageEnergy;
+    report["dram energy [J]"] = dramEnergy;
+    report["total energy [J]"] = packageEnergy + dramEnergy;
+    return report;
+  }
+
+  void addEnergyPerAction(nlohmann::json& energy, nlohmann::json const& report) {
+    if (not energy.contains("total energy [J]") or not report.is_object()) {
+      return;
+    }
+    // The probe only sees the kernel as a whole, so there's no telling how the energy is split
+    // between different actions. We can only average over all of them.
+    std::uint64_t count = 0U;
+    auto addActions = [&count](nlohmann::json const& logs) {
+      if (not logs.is_object()) {
+        return;
+      }
+      for (std::string const action : actions) {
+        auto const entry = logs.find(action + " count");
+        if (entry != logs.end() and entry->is_number()) {
+          count += entry->get<std::uint64_t>();
+        }
+      }
+    };
+    addActions(report.value("logs", nlohmann::json{}));
+    auto const groups = report.find("groups");
+    if (groups != report.end() and groups->is_object()) {
+      for (auto const& group : *groups) {
+        addActions(group.value("logs", nlohmann::json{}));
+      }
+    }
+    if (count > 0U) {
+      energy["counted actions"] = count;
+      energy["energy per action [nJ]"]
+          = energy["total energy [J]"].get<double>() * 1e9 / static_cast<double>(count);
+    }
+  }
+}  // namespace kitgenbench
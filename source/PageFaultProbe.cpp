@@ -0,0 +1,42 @@
+#include <kitgenbench/PageFaultProbe.h>
+#include <sys/resource.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace kitgenbench {
+  namespace {
+    // The file lists all modes with the active one in brackets, e.g. "always [madvise] never".
+    nlohmann::json readHugePageMode(std::filesystem::path const& setting) {
+      std::ifstream file(setting);
+      std::string line;
+      std::getline(file, line);
+      auto const begin = line.find('[');
+      auto const end = line.find(']');
+      if (begin == std::string::npos or end == std::string::npos or end < begin) {
+        return nullptr;
+      }
+      return line.substr(begin + 1, end - begin - 1);
+    }
+  }  // namespace
+
+  void PageFaultProbe::start() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    minorFaults = usage.ru_minflt;
+    majorFaults = usage.ru_majflt;
+  }
+
+  nlohmann::json PageFaultProbe::stop() const {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return {{"error", std::string("getrusage failed: ") + std::strerror(errno)}};
+    }
+    return {{"minor faults", usage.ru_minflt - minorFaults},
+            {"major faults", usage.ru_majflt - majorFaults},
+            {"transparent huge pages", readHugePageMode(hugePageSetting)}};
+  }
+}  // namespace kitgenbench
@@ -0,0 +1,154 @@
+#include <elf.h>
+#include <kitgenbench/ResultCache.h>
+#include <link.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace kitgenbench {
+  namespace {
+    // Fields of `lscpu` that describe the hardware. Others, e.g. the current clock frequency,
+    // change from call to call.
+    constexpr std::array relevantHostInfo{"Architecture",     "Model name",       "CPU(s)",
+                                          "Thread(s) per core", "Core(s) per socket", "Socket(s)",
+                                          "NUMA node(s)",     "L1d cache",        "L2 cache",
+                                          "L3 cache"};
+
+    /**
+     * @brief 64-bit FNV-1a hash. Not cryptographic but plenty for telling setups apart, in
+     * particular because the cached files are checked against their full identity.
+     */
+    std::uint64_t hash(std::string_view const data, std::uint64_t value = 14695981039346656037ULL) {
+      for (auto const character : data) {
+        value ^= static_cast<unsigned char>(character);
+        value *= 1099511628211ULL;
+      }
+      return value;
+    }
+
+    std::string toHex(unsigned char const* data, std::size_t const size) {
+      constexpr std::string_view digits = "0123456789abcdef";
+      std::string result{};
+      for (std::size_t i = 0U; i < size; ++i) {
+        result += digits[data[i] >> 4U];
+        result += digits[data[i] & 0xfU];
+      }
+      return result;
+    }
+
+    std::string toHex(std::uint64_t const value) {
+      std::array<unsigned char, sizeof(value)> bytes{};
+      for (std::size_t i = 0U; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<unsigned char>(value >> (8U * (bytes.size() - 1U - i)));
+      }
+      return toHex(bytes.data(), bytes.size());
+    }
+
+    // The first object reported by `dl_iterate_phdr` is the executable itself.
+    int findBuildIdNote(dl_phdr_info* info, std::size_t, void* buildId) {
+      for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+        auto const& header = info->dlpi_phdr[i];
+        if (header.p_type != PT_NOTE) {
+          continue;
+        }
+        auto const* note = reinterpret_cast<char const*>(info->dlpi_addr + header.p_vaddr);
+        auto const* end = note + header.p_memsz;
+        while (note + sizeof(ElfW(Nhdr)) <= end) {
+          auto const* noteHeader = reinterpret_cast<ElfW(Nhdr) const*>(note);
+          auto const* name = note + sizeof(ElfW(Nhdr));
+          auto const* description = name + ((noteHeader->n_namesz + 3U) & ~3U);
+          if (noteHeader->n_type == NT_GNU_BUILD_ID and noteHeader->n_namesz == 4U
+              and std::memcmp(name, "GNU", 4U) == 0) {
+            *static_cast<std::string*>(buildId) = toHex(
+                reinterpret_cast<unsigned char const*>(description), noteHeader->n_descsz);
+            return 1;
+          }
+          note = description + ((noteHeader->n_descsz + 3U) & ~3U);
+        }
+      }
+      return 1;
+    }
+
+    nlohmann::json relevantHostMetadata(nlohmann::json const& metadata) {
+      if (not metadata.is_object()) {
+        return {};
+      }
+      nlohmann::json result{{"host name", metadata.value("host name", "")},
+                            {"device info", metadata.value("device info", nlohmann::json{})}};
+      auto const hostInfo = metadata.value("host info", nlohmann::json::object());
+      for (std::string const field : relevantHostInfo) {
+        if (hostInfo.contains(field)) {
+          result["host info"][field] = hostInfo[field];
+        }
+      }
+      return result;
+    }
+  }  // namespace
+
+  std::string getBuildId() {
+    std::string buildId{};
+    dl_iterate_phdr(findBuildIdNote, &buildId);
+    if (buildId.empty()) {
+      std::ifstream executable("/proc/self/exe", std::ios::binary);
+      std::string const content{std::istreambuf_iterator<char>(executable),
+                                std::istreambuf_iterator<char>()};
+      buildId = "content:" + toHex(hash(content));
+    }
+    return buildId;
+  }
+
+  ResultCache::ResultCache(std::filesystem::path directory, nlohmann::json const& metadata,
+                           std::string buildId)
+      : directory(std::move(directory)),
+        environment({{"build id", std::move(buildId)}, {"host", relevantHostMetadata(metadata)}}) {
+    if (not this->directory.empty()) {
+      std::filesystem::create_directories(this->directory);
+    }
+  }
+
+  std::string ResultCache::key(nlohmann::json const& identity) const {
+    // Objects are sorted by key in nlohmann::json, so the dump is canonical.
+    return toHex(hash(identity.dump(), hash(environment.dump())));
+  }
+
+  std::optional<nlohmann::json> ResultCache::load(std::string const& key,
+                                                  nlohmann::json const& identity) {
+    if (directory.empty()) {
+      return std::nullopt;
+    }
+    std::ifstream file(directory / (key + ".json"));
+    auto const content = nlohmann::json::parse(file, nullptr, false);
+    if (content.is_discarded() or not content.is_object() or not content.contains("result")
+        or content.value("environment", nlohmann::json{}) != environment
+        or content.value("identity", nlohmann::json{}) != identity) {
+      misses++;
+      return std::nullopt;
+    }
+    hits++;
+    auto result = content["result"];
+    result["from cache"] = true;
+    return result;
+  }
+
+  void ResultCache::store(std::string const& key, nlohmann::json const& identity,
+                          nlohmann::json const& result) const {
+    if (directory.empty()) {
+      return;
+    }
+    auto const path = directory / (key + ".json");
+    // Write to a temporary file first, so an interrupted run never leaves a truncated result.
+    auto temporary = path;
+    temporary += ".tmp";
+    std::ofstream(temporary) << nlohmann::json{
+        {"environment", environment}, {"identity", identity}, {"result", result}};
+    std::filesystem::rename(temporary, path);
+  }
+}  // namespace kitgenbench
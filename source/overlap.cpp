@@ -0,0 +1,164 @@
+#include <kitgenbench/overlap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace kitgenbench::overlap {
+  namespace {
+    // Maximal number of overlapping pairs listed in the report.
+    constexpr std::size_t maxExamples = 10U;
+
+    /**
+     * @brief Sorts chunks of the range in parallel and merges them pairwise afterwards.
+     */
+    template <typename T, typename TCompare>
+    void parallelSort(std::vector<T>& values, TCompare comp, unsigned numWorkers) {
+      if (values.empty()) {
+        return;
+      }
+      auto const chunkSize = (values.size() + numWorkers - 1) / numWorkers;
+      std::vector<std::size_t> bounds{};
+      for (std::size_t i = 0U; i < values.size(); i += chunkSize) {
+        bounds.push_back(i);
+      }
+      bounds.push_back(values.size());
+
+      {
+        std::vector<std::jthread> workers{};
+        for (std::size_t c = 0U; c + 1 < bounds.size(); ++c) {
+          workers.emplace_back([&values, &comp, lo = bounds[c], hi = bounds[c + 1]] {
+            std::sort(values.begin() + lo, values.begin() + hi, comp);
+          });
+        }
+      }
+
+      while (bounds.size() > 2U) {
+        auto const numChunks = bounds.size() - 1;
+        std::vector<std::size_t> merged{};
+        {
+          std::vector<std::jthread> workers{};
+          for (std::size_t c = 0U; c + 1 < numChunks; c += 2) {
+            workers.emplace_back(
+                [&values, &comp, lo = bounds[c], mid = bounds[c + 1], hi = bounds[c + 2]] {
+                  std::inplace_merge(values.begin() + lo, values.begin() + mid,
+                                     values.begin() + hi, comp);
+                });
+            merged.push_back(bounds[c]);
+          }
+        }
+        if (numChunks % 2 == 1) {
+          merged.push_back(bounds[numChunks - 1]);
+        }
+        merged.push_back(bounds.back());
+        bounds = std::move(merged);
+      }
+    }
+
+    bool aliveAtTheSameTime(Allocation const& lhs, Allocation const& rhs) {
+      if (lhs.thread == rhs.thread) {
+        return lhs.aliveFromSequence <= rhs.aliveUntilSequence
+               and rhs.aliveFromSequence <= lhs.aliveUntilSequence;
+      }
+      // Equal stamps of different threads don't tell which came first.
+      return lhs.aliveFrom < rhs.aliveUntil and rhs.aliveFrom < lhs.aliveUntil;
+    }
+
+    nlohmann::json toJson(Allocation const& allocation) {
+      return {{"begin", allocation.begin},
+              {"end", allocation.end},
+              {"alive from", allocation.aliveFrom},
+              {"alive until", allocation.aliveUntil}};
+    }
+  }  // namespace
+
+  std::vector<Allocation> pairEvents(std::vector<Event> events, std::size_t& unmatched) {
+    std::ranges::sort(events, [](auto const& lhs, auto const& rhs) {
+      return lhs.thread < rhs.thread or (lhs.thread == rhs.thread and lhs.sequence < rhs.sequence);
+    });
+
+    std::vector<Allocation> allocations{};
+    std::unordered_map<std::uintptr_t, std::size_t> open{};
+    for (std::size_t i = 0U; i < events.size(); ++i) {
+      auto const& event = events[i];
+      if (i > 0 and events[i - 1].thread != event.thread) {
+        open.clear();
+      }
+      if (not event.isFree) {
+        open[event.begin] = allocations.size();
+        allocations.push_back(
+            {event.begin, event.end, event.stamp, Allocation{}.aliveUntil, event.thread,
+             event.sequence});
+        continue;
+      }
+      auto match = open.find(event.begin);
+      if (match == open.end()) {
+        unmatched++;
+        continue;
+      }
+      allocations[match->second].aliveUntil = event.previousStamp;
+      // The matched allocation came earlier, so the sequence is positive.
+      allocations[match->second].aliveUntilSequence = event.sequence - 1U;
+      open.erase(match);
+    }
+    return allocations;
+  }
+
+  nlohmann::json findOverlaps(std::vector<Allocation>& allocations, unsigned numWorkers) {
+    if (numWorkers == 0U) {
+      numWorkers = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    parallelSort(
+        allocations,
+        [](auto const& lhs, auto const& rhs) {
+          return lhs.begin < rhs.begin
+                 or (lhs.begin == rhs.begin and lhs.aliveFrom < rhs.aliveFrom);
+        },
+        numWorkers);
+
+    // Every allocation is only compared to those starting within its own range, so the cost is
+    // linear unless the same memory is handed out many times.
+    std::vector<std::size_t> counts(numWorkers, 0U);
+    std::vector<nlohmann::json> examples(numWorkers, nlohmann::json::array());
+    auto const chunkSize = (allocations.size() + numWorkers - 1) / numWorkers;
+    {
+      std::vector<std::jthread> workers{};
+      for (unsigned w = 0U; w < numWorkers; ++w) {
+        workers.emplace_back([&, w] {
+          auto const hi = std::min(allocations.size(), (w + 1) * chunkSize);
+          for (std::size_t i = w * chunkSize; i < hi; ++i) {
+            auto const& current = allocations[i];
+            for (std::size_t j = i + 1;
+                 j < allocations.size() and allocations[j].begin < current.end; ++j) {
+              auto const& other = allocations[j];
+              if (other.begin == other.end or not aliveAtTheSameTime(current, other)) {
+                continue;
+              }
+              counts[w]++;
+              if (examples[w].size() < maxExamples) {
+                examples[w].push_back({toJson(current), toJson(other)});
+              }
+            }
+          }
+        });
+      }
+    }
+
+    std::size_t count = 0U;
+    auto allExamples = nlohmann::json::array();
+    for (unsigned w = 0U; w < numWorkers; ++w) {
+      count += counts[w];
+      for (auto const& example : examples[w]) {
+        if (allExamples.size() < maxExamples) {
+          allExamples.push_back(example);
+        }
+      }
+    }
+    return {{"checked allocations", allocations.size()},
+            {"overlapping pairs", count},
+            {"examples", allExamples}};
+  }
+}  // namespace kitgenbench::overlap
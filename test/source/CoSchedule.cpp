@@ -0,0 +1,126 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/CoSchedule.h>
+#include <kitgenbench/kitgenbench.h>
+#include <kitgenbench/setup.h>
+
+#include <alpaka/core/Common.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace {
+  using Dim = alpaka::DimInt<1>;
+  using Idx = std::uint32_t;
+  using Acc
+      = alpaka::TagToAcc<std::remove_cvref_t<decltype(std::get<0>(alpaka::EnabledAccTags{}))>,
+                         Dim, Idx>;
+
+  // Which group and thread took a step, in the order they were taken.
+  using Trace = std::vector<std::pair<char, std::uint32_t>>;
+
+  struct TraceRecipe {
+    char group{};
+    std::uint32_t index{0U};
+    Trace* trace{nullptr};
+    std::uint32_t counter{0U};
+
+    ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+      if (counter >= 2U) return std::make_tuple(kitgenbench::Actions::STOP);
+      trace->emplace_back(group, index);
+      counter++;
+      return std::make_tuple(+kitgenbench::Actions::CHECK);
+    }
+  };
+
+  struct TraceRecipes {
+    char group{};
+    Trace* trace{nullptr};
+    std::uint32_t stored{0U};
+    ALPAKA_FN_ACC TraceRecipe load(auto const threadIndex) {
+      return {group, static_cast<std::uint32_t>(threadIndex), trace};
+    }
+    ALPAKA_FN_ACC void store(const auto&, TraceRecipe&&, auto const) { stored++; }
+  };
+
+  template <typename T> struct Default {
+    ALPAKA_FN_ACC T load(auto const) { return {}; }
+    ALPAKA_FN_ACC void store(const auto&, T&&, auto const) {}
+  };
+
+  struct InstructionDetails {
+    TraceRecipes recipes{};
+    Default<kitgenbench::setup::NoLogger> loggers{};
+    Default<kitgenbench::setup::NoChecker> checkers{};
+
+    auto sendTo([[maybe_unused]] auto const& device, [[maybe_unused]] auto& queue) { return this; }
+    auto retrieveFrom([[maybe_unused]] auto const& device, [[maybe_unused]] auto& queue) {}
+    nlohmann::json generateReport() { return {{"logs", {{"stored recipes", recipes.stored}}}}; }
+  };
+
+  auto composeGroup(char const group, Trace& trace, alpaka::WorkDivMembers<Dim, Idx> workdiv) {
+    auto const platformAcc = alpaka::Platform<Acc>{};
+    auto const dev = alpaka::getDevByIdx(platformAcc, 0);
+    return kitgenbench::setup::composeSetup(
+        std::string{group}, kitgenbench::ExecutionDetails<Acc, decltype(dev)>{workdiv, dev},
+        InstructionDetails{{group, &trace}}, {{"group", std::string{group}}});
+  }
+
+  auto emulated(Idx const numThreads) {
+    return alpaka::WorkDivMembers<Dim, Idx>{alpaka::Vec<Dim, Idx>{1}, alpaka::Vec<Dim, Idx>{1},
+                                            alpaka::Vec<Dim, Idx>{numThreads}};
+  }
+}  // namespace
+
+TEST_CASE("Co-scheduling setups") {
+  Trace trace{};
+  auto first = composeGroup('a', trace, emulated(2U));
+  auto second = composeGroup('b', trace, emulated(3U));
+  auto setup
+      = kitgenbench::coschedule::composeSetup("Together", std::move(first), std::move(second));
+  setup.execution.interleaving = {kitgenbench::Interleaving::Mode::roundRobin};
+
+  auto report = kitgenbench::runBenchmark(setup);
+  CHECK(trace
+        == Trace{{'a', 0}, {'a', 1}, {'b', 0}, {'b', 1}, {'b', 2},
+                 {'a', 0}, {'a', 1}, {'b', 0}, {'b', 1}, {'b', 2}});
+  CHECK(report["groups"]["a"]["logs"]["stored recipes"] == 2U);
+  CHECK(report["groups"]["b"]["logs"]["stored recipes"] == 3U);
+  CHECK(report["groups"]["b"]["virtual threads"] == nlohmann::json{2U, 5U});
+  CHECK(report["description"]["groups"]["b"]["group"] == "b");
+
+  SUBCASE("compared with solo runs") {
+    nlohmann::json const solo{{"a",
+                               {{"interleaving", report["interleaving"]},
+                                {"logs", {{"allocation average time [ms]", 2.0}}}}}};
+    report["groups"]["a"]["logs"]["allocation average time [ms]"] = 3.0;
+    auto const comparison = kitgenbench::coschedule::compareWithSolo(report, solo);
+    CHECK(comparison["groups"]["a"]["slowdown"]["allocation average time [ms]"] == 1.5);
+    CHECK(comparison["groups"]["a"]["solo"] == solo["a"]);
+    CHECK(comparison["groups"]["a"]["co-scheduled"]["logs"]["stored recipes"] == 2U);
+    CHECK(comparison["groups"]["b"] == report["groups"]["b"]);
+  }
+
+  SUBCASE("not compared with solo runs in a different order") {
+    nlohmann::json const solo{{"a",
+                               {{"interleaving", kitgenbench::Interleaving{}.generateReport()},
+                                {"logs", {{"allocation average time [ms]", 2.0}}}}}};
+    auto const comparison = kitgenbench::coschedule::compareWithSolo(report, solo);
+    CHECK(comparison["groups"]["a"].contains("error"));
+    CHECK_FALSE(comparison["groups"]["a"].contains("slowdown"));
+  }
+}
+
+TEST_CASE("Co-scheduling needs compatible work divisions") {
+  Trace trace{};
+  auto first = composeGroup(
+      'a', trace,
+      {alpaka::Vec<Dim, Idx>{1}, alpaka::Vec<Dim, Idx>{2}, alpaka::Vec<Dim, Idx>{1}});
+  auto second = composeGroup('b', trace, emulated(3U));
+  CHECK_THROWS_AS(
+      kitgenbench::coschedule::composeSetup("Together", std::move(first), std::move(second)),
+      std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/EnergyProbe.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+  void writeFile(std::filesystem::path const& file, std::string const& content) {
+    std::ofstream(file) << content << "\n";
+  }
+
+  // Mimics the layout of /sys/class/powercap with one package, its DRAM and core zones as well as
+  // the MMIO duplicate of the package.
+  auto makeFakePowercap() {
+    auto root = std::filesystem::temp_directory_path() / "kitgenbench-fake-powercap";
+    std::filesystem::remove_all(root);
+    auto makeZone = [&root](std::string const& id, std::string const& name) {
+      std::filesystem::create_directories(root / id);
+      writeFile(root / id / "name", name);
+      writeFile(root / id / "max_energy_range_uj", "1000000000");
+      writeFile(root / id / "energy_uj", "999000000");
+    };
+    makeZone("intel-rapl:0", "package-0");
+    makeZone("intel-rapl:0:0", "core");
+    makeZone("intel-rapl:0:1", "dram");
+    makeZone("intel-rapl-mmio:0", "package-0");
+    return root;
+  }
+}  // namespace
+
+TEST_CASE("Energy probe") {
+  auto const root = makeFakePowercap();
+  kitgenbench::EnergyProbe probe{root};
+  CHECK(probe.error.empty());
+  REQUIRE(probe.zones.size() == 2U);
+
+  probe.start();
+  writeFile(root / "intel-rapl:0" / "energy_uj", "999500000");
+  // This one wrapped around.
+  writeFile(root / "intel-rapl:0:1" / "energy_uj", "250000");
+  auto energy = probe.stop();
+
+  CHECK(energy["package energy [J]"].get<double>() == doctest::Approx(0.5));
+  CHECK(energy["dram energy [J]"].get<double>() == doctest::Approx(1.25));
+  CHECK(energy["total energy [J]"].get<double>() == doctest::Approx(1.75));
+  CHECK(energy["zones"]["intel-rapl:0:1"]["name"] == "dram");
+
+  auto withoutActions = energy;
+  kitgenbench::addEnergyPerAction(withoutActions, {{"logs", {{"allocation count", 0}}}});
+  CHECK_FALSE(withoutActions.contains("energy per action [nJ]"));
+
+  auto coScheduled = energy;
+  kitgenbench::addEnergyPerAction(
+      coScheduled, {{"groups",
+                     {{"a", {{"logs", {{"allocation count", 500}}}}},
+                      {"b", {{"logs", {{"deallocation count", 1250}}}}}}}});
+  CHECK(coScheduled["counted actions"] == 1750);
+
+  kitgenbench::addEnergyPerAction(
+      energy, {{"logs", {{"allocation count", 1000}, {"deallocation count", 750}}}});
+  CHECK(energy["counted actions"] == 1750);
+  CHECK(energy["energy per action [nJ]"].get<double>() == doctest::Approx(1e6));
+
+  std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Energy probe without RAPL") {
+  kitgenbench::EnergyProbe probe{"/this/path/does/not/exist"};
+  probe.start();
+  CHECK(probe.stop().contains("error"));
+}
@@ -0,0 +1,73 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/HandoffQueue.h>
+
+#include <alpaka/alpaka.hpp>
+#include <cstdint>
+#include <vector>
+
+using Dim = alpaka::DimInt<1>;
+using Idx = std::uint32_t;
+using Acc = alpaka::TagToAcc<std::remove_cvref_t<decltype(std::get<0>(alpaka::EnabledAccTags{}))>,
+                             Dim, Idx>;
+using Queue = kitgenbench::HandoffQueue<std::uint32_t>;
+
+namespace {
+  struct FillAndDrainKernel {
+    template <typename TAcc>
+    ALPAKA_FN_ACC auto operator()(TAcc const& acc, Queue* queue, std::uint32_t* results) const
+        -> void {
+      // Go around twice to make sure the cells are properly recycled.
+      for (std::uint32_t round = 0U; round < 2U; ++round) {
+        std::uint32_t pushed = 0U;
+        while (queue->tryPush(acc, pushed)) {
+          pushed++;
+        }
+        std::uint32_t popped = 0U;
+        std::uint32_t value = 0U;
+        std::uint32_t inOrder = 1U;
+        while (queue->tryPop(acc, value)) {
+          inOrder &= (value == popped);
+          popped++;
+        }
+        results[3 * round] = pushed;
+        results[3 * round + 1] = popped;
+        results[3 * round + 2] = inOrder;
+      }
+    }
+  };
+}  // namespace
+
+TEST_CASE("Handoff queue") {
+  static constexpr std::uint32_t capacity = 5U;
+  auto const platformAcc = alpaka::Platform<Acc>{};
+  auto const dev = alpaka::getDevByIdx(platformAcc, 0);
+  auto const platformHost = alpaka::PlatformCpu{};
+  auto const devHost = alpaka::getDevByIdx(platformHost, 0);
+  auto queue = alpaka::Queue<Acc, alpaka::Blocking>(dev);
+
+  auto cellsBuffer = alpaka::allocBuf<Queue::Cell, Idx>(dev, capacity);
+  auto cells = Queue::initCells(capacity);
+  auto cellsView = alpaka::createView(devHost, cells.data(), capacity);
+  alpaka::memcpy(queue, cellsBuffer, cellsView);
+
+  auto queueBuffer = alpaka::allocBuf<Queue, Idx>(dev, 1U);
+  Queue handoffQueue{alpaka::getPtrNative(cellsBuffer), capacity};
+  auto queueView = alpaka::createView(devHost, &handoffQueue, 1U);
+  alpaka::memcpy(queue, queueBuffer, queueView);
+
+  auto resultsBuffer = alpaka::allocBuf<std::uint32_t, Idx>(dev, 6U);
+  alpaka::exec<Acc>(queue, alpaka::WorkDivMembers<Dim, Idx>{Idx{1}, Idx{1}, Idx{1}},
+                    FillAndDrainKernel{}, alpaka::getPtrNative(queueBuffer),
+                    alpaka::getPtrNative(resultsBuffer));
+
+  std::vector<std::uint32_t> results(6U);
+  auto resultsView = alpaka::createView(devHost, results.data(), 6U);
+  alpaka::memcpy(queue, resultsView, resultsBuffer);
+  alpaka::wait(queue);
+
+  for (std::uint32_t round = 0U; round < 2U; ++round) {
+    CHECK(results[3 * round] == capacity);
+    CHECK(results[3 * round + 1] == capacity);
+    CHECK(results[3 * round + 2] == 1U);
+  }
+}
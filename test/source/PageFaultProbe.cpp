@@ -0,0 +1,40 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/PageFaultProbe.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("Page fault probe") {
+  auto const pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  std::size_t const numPages = 64U;
+  auto* memory = static_cast<char*>(mmap(nullptr, numPages * pageSize, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  REQUIRE(memory != MAP_FAILED);
+  // Otherwise, a single huge page fault could serve all of them.
+  madvise(memory, numPages * pageSize, MADV_NOHUGEPAGE);
+
+  kitgenbench::PageFaultProbe probe{};
+  probe.start();
+  for (std::size_t i = 0U; i < numPages; ++i) {
+    memory[i * pageSize] = 1;
+  }
+  auto const report = probe.stop();
+  munmap(memory, numPages * pageSize);
+
+  CHECK(report["minor faults"].get<long>() + report["major faults"].get<long>()
+        >= static_cast<long>(numPages));
+}
+
+TEST_CASE("Transparent huge page mode") {
+  auto const setting = std::filesystem::temp_directory_path() / "kitgenbench-fake-thp";
+  std::ofstream(setting) << "always [madvise] never\n";
+  kitgenbench::PageFaultProbe probe{0, 0, setting};
+  CHECK(probe.stop()["transparent huge pages"] == "madvise");
+
+  probe.hugePageSetting = "/this/path/does/not/exist";
+  CHECK(probe.stop()["transparent huge pages"].is_null());
+  std::filesystem::remove(setting);
+}
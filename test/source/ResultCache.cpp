@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/ResultCache.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "nlohmann/json.hpp"
+
+namespace {
+  nlohmann::json const metadata{{"start time", "today"},
+                                {"host name", "somewhere"},
+                                {"host info", {{"Model name", "Fancy CPU"}, {"CPU MHz", "1234"}}}};
+  nlohmann::json const identity{{"name", "setup"}, {"description", {{"size", 16}}}};
+}  // namespace
+
+TEST_CASE("Build ID") {
+  CHECK_FALSE(kitgenbench::getBuildId().empty());
+  CHECK(kitgenbench::getBuildId() == kitgenbench::getBuildId());
+}
+
+TEST_CASE("Result cache") {
+  auto const directory = std::filesystem::temp_directory_path() / "kitgenbench-result-cache";
+  std::filesystem::remove_all(directory);
+  kitgenbench::ResultCache cache{directory, metadata, "build"};
+  auto const key = cache.key(identity);
+
+  SUBCASE("keys") {
+    CHECK(key == cache.key(identity));
+    CHECK(key != cache.key({{"name", "setup"}, {"description", {{"size", 32}}}}));
+    CHECK(key != kitgenbench::ResultCache(directory, metadata, "rebuild").key(identity));
+    auto later = metadata;
+    later["start time"] = "tomorrow";
+    later["host info"]["CPU MHz"] = "2345";
+    CHECK(key == kitgenbench::ResultCache(directory, later, "build").key(identity));
+    later["host name"] = "elsewhere";
+    CHECK(key != kitgenbench::ResultCache(directory, later, "build").key(identity));
+  }
+
+  SUBCASE("store and load") {
+    CHECK_FALSE(cache.load(key, identity));
+    cache.store(key, identity, {{"total runtime [ms]", 42}});
+    auto const result = cache.load(key, identity);
+    REQUIRE(result);
+    CHECK((*result)["total runtime [ms]"] == 42);
+    CHECK((*result)["from cache"] == true);
+    CHECK(cache.hits == 1U);
+    CHECK(cache.misses == 1U);
+  }
+
+  SUBCASE("invalid entries are ignored") {
+    std::ofstream(directory / (key + ".json")) << "{\"result\": ";
+    CHECK_FALSE(cache.load(key, identity));
+    cache.store(key, {{"name", "another setup"}}, {});
+    CHECK_FALSE(cache.load(key, identity));
+  }
+
+  SUBCASE("disabled") {
+    kitgenbench::ResultCache disabled{"", metadata, "build"};
+    disabled.store(key, identity, {});
+    CHECK_FALSE(disabled.load(key, identity));
+  }
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,40 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/SizeList.h>
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+using Sizes = kitgenbench::PowersOfTwo<8U, 64U * 1024U>;
+
+TEST_CASE("Powers of two") {
+  static_assert(std::is_same_v<kitgenbench::PowersOfTwo<4U, 32U>,
+                               kitgenbench::SizeList<4U, 8U, 16U, 32U>>);
+  static_assert(Sizes::values.size() == 14U);
+  static_assert(Sizes::values.back() == 64U * 1024U);
+  static_assert(Sizes::contains(1024U));
+  static_assert(not Sizes::contains(24U));
+}
+
+TEST_CASE("Dispatching sizes") {
+  auto extentOf = [](std::size_t const size) {
+    return Sizes::dispatch(size, [](auto extent) { return decltype(extent)::value; });
+  };
+  CHECK(extentOf(8U) == 8U);
+  CHECK(extentOf(4096U) == 4096U);
+  CHECK(extentOf(24U) == std::dynamic_extent);
+  CHECK(extentOf(128U * 1024U) == std::dynamic_extent);
+}
+
+TEST_CASE("Spans of listed sizes") {
+  std::byte buffer[32];
+  Sizes::Spans<std::byte> fixed = std::span<std::byte, 16U>(buffer, 16U);
+  Sizes::Spans<std::byte> dynamic = std::span<std::byte, 24U>(buffer, 24U);
+  CHECK(std::holds_alternative<std::span<std::byte, 16U>>(fixed));
+  CHECK(std::holds_alternative<std::span<std::byte>>(dynamic));
+  CHECK(kitgenbench::asDynamicSpan(fixed).size() == 16U);
+  CHECK(kitgenbench::asDynamicSpan(dynamic).size() == 24U);
+  CHECK(kitgenbench::asDynamicSpan(dynamic).data() == buffer);
+  CHECK(kitgenbench::visitAlternatives([](auto range) { return decltype(range)::extent; }, fixed)
+        == 16U);
+}
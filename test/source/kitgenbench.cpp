@@ -5,6 +5,7 @@
 #include <sys/types.h>
 
 #include <alpaka/core/Common.hpp>
+#include <filesystem>
 #include <string>
 
 #include "nlohmann/json.hpp"
@@ -180,3 +181,84 @@ TEST_CASE("Malloc free many size") {
   auto setup = setups::mallocFreeManySize::composeSetup();
   auto benchmarkReports = runBenchmarks(setup);
 }
+
+namespace setups::interleaving {
+
+  // Every virtual thread takes three steps, noting down its index with each of them.
+  struct OrderRecipe {
+    std::uint32_t index{0U};
+    std::vector<std::uint32_t>* order{nullptr};
+    std::uint32_t counter{0U};
+
+    ALPAKA_FN_ACC auto next([[maybe_unused]] const auto& acc) {
+      if (counter >= 3U) return std::make_tuple(kitgenbench::Actions::STOP);
+      order->push_back(index);
+      counter++;
+      return std::make_tuple(+kitgenbench::Actions::MALLOC);
+    }
+  };
+
+  struct OrderRecipes {
+    std::vector<std::uint32_t> order{};
+    ALPAKA_FN_ACC OrderRecipe load(auto const threadIndex) {
+      return {static_cast<std::uint32_t>(threadIndex), &order};
+    }
+    ALPAKA_FN_ACC void store(const auto&, OrderRecipe&&, auto const) {}
+    nlohmann::json generateReport() { return {}; }
+  };
+
+  struct InstructionDetails {
+    OrderRecipes recipes{};
+    Aggregate<kitgenbench::setup::NoLogger> loggers{};
+    Aggregate<kitgenbench::setup::NoChecker> checkers{};
+
+    auto sendTo([[maybe_unused]] auto const& device, [[maybe_unused]] auto& queue) { return this; }
+    auto retrieveFrom([[maybe_unused]] auto const& device, [[maybe_unused]] auto& queue) {}
+    nlohmann::json generateReport() { return {}; }
+  };
+
+  auto runWith(kitgenbench::Interleaving const interleaving) {
+    auto execution = makeExecutionDetails();
+    execution.workdiv = alpaka::WorkDivMembers<Dim, Idx>{
+        alpaka::Vec<Dim, Idx>{1}, alpaka::Vec<Dim, Idx>{1}, alpaka::Vec<Dim, Idx>{3}};
+    execution.interleaving = interleaving;
+    auto setup
+        = kitgenbench::setup::composeSetup("Interleaving", execution, InstructionDetails{}, {});
+    kitgenbench::runBenchmarks(setup);
+    return setup.instructions.recipes.order;
+  }
+}  // namespace setups::interleaving
+
+TEST_CASE("Interleaving virtual threads") {
+  using kitgenbench::Interleaving;
+  using Order = std::vector<std::uint32_t>;
+
+  CHECK(setups::interleaving::runWith({}) == Order{0, 0, 0, 1, 1, 1, 2, 2, 2});
+  CHECK(setups::interleaving::runWith({Interleaving::Mode::roundRobin})
+        == Order{0, 1, 2, 0, 1, 2, 0, 1, 2});
+
+  auto const random = setups::interleaving::runWith({Interleaving::Mode::random, 42U});
+  CHECK(random == setups::interleaving::runWith({Interleaving::Mode::random, 42U}));
+  CHECK(std::ranges::is_permutation(random, Order{0, 0, 0, 1, 1, 1, 2, 2, 2}));
+}
+
+TEST_CASE("Skipping cached setups") {
+  auto const directory = std::filesystem::temp_directory_path() / "kitgenbench-skip-cached";
+  std::filesystem::remove_all(directory);
+  kitgenbench::ResultCache cache{directory, {}, "build"};
+  auto setup = setups::mallocFreeManySize::composeSetup();
+
+  auto first = kitgenbench::runBenchmarks(cache, setup);
+  CHECK(first["setups from cache"] == 0U);
+  CHECK_FALSE(first["mallocFreeManySize"].contains("from cache"));
+
+  auto second = kitgenbench::runBenchmarks(cache, setup);
+  CHECK(second["setups from cache"] == 1U);
+  CHECK(second["mallocFreeManySize"]["from cache"] == true);
+
+  setup.description["number of allocations"] = 1;
+  auto changed = kitgenbench::runBenchmarks(cache, setup);
+  CHECK(changed["setups from cache"] == 0U);
+
+  std::filesystem::remove_all(directory);
+}
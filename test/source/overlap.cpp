@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+#include <kitgenbench/overlap.h>
+
+#include <cstdint>
+#include <vector>
+
+using kitgenbench::overlap::Allocation;
+using kitgenbench::overlap::Event;
+
+TEST_CASE("Pairing allocation events") {
+  std::size_t unmatched = 0U;
+  // Thread 0 allocates the same address twice, freeing it in between, and thread 1 frees
+  // something it never got.
+  auto allocations = kitgenbench::overlap::pairEvents({{100U, 116U, 3U, 2U, 0U, 2U, true},
+                                                       {100U, 116U, 0U, 0U, 0U, 0U, false},
+                                                       {100U, 116U, 5U, 3U, 0U, 3U, false},
+                                                       {200U, 216U, 2U, 0U, 0U, 1U, false},
+                                                       {300U, 316U, 4U, 1U, 1U, 0U, true}},
+                                                      unmatched);
+  CHECK(unmatched == 1U);
+  REQUIRE(allocations.size() == 3U);
+  CHECK(allocations[0].aliveFrom == 0U);
+  CHECK(allocations[0].aliveUntil == 2U);
+  CHECK(allocations[0].aliveUntilSequence == 1U);
+  CHECK(allocations[1].begin == 200U);
+  CHECK(allocations[2].aliveFrom == 5U);
+  CHECK(allocations[2].aliveFromSequence == 3U);
+  CHECK(allocations[2].aliveUntil == Allocation{}.aliveUntil);
+}
+
+TEST_CASE("Finding overlapping allocations") {
+  SUBCASE("disjoint ranges") {
+    std::vector<Allocation> allocations{};
+    for (std::uintptr_t i = 0U; i < 1000U; ++i) {
+      allocations.push_back({(999U - i) * 16U, (1000U - i) * 16U, i});
+    }
+    auto report = kitgenbench::overlap::findOverlaps(allocations, 3U);
+    CHECK(report["checked allocations"] == 1000U);
+    CHECK(report["overlapping pairs"] == 0U);
+  }
+
+  constexpr auto forever = Allocation{}.aliveUntil;
+
+  SUBCASE("reuse after free is fine") {
+    std::vector<Allocation> allocations{{0U, 16U, 0U, 1U, 0U}, {0U, 16U, 2U, forever, 1U}};
+    auto report = kitgenbench::overlap::findOverlaps(allocations, 2U);
+    CHECK(report["overlapping pairs"] == 0U);
+  }
+
+  SUBCASE("equal stamps of different threads are not an overlap") {
+    std::vector<Allocation> allocations{{0U, 16U, 0U, 1U, 0U}, {0U, 16U, 1U, forever, 1U}};
+    auto report = kitgenbench::overlap::findOverlaps(allocations, 2U);
+    CHECK(report["overlapping pairs"] == 0U);
+  }
+
+  SUBCASE("within a thread, the sequence decides") {
+    std::vector<Allocation> allocations{{0U, 16U, 0U, 1U, 0U, 0U, 1U},
+                                        {0U, 16U, 1U, forever, 0U, 4U}};
+    auto report = kitgenbench::overlap::findOverlaps(allocations, 2U);
+    CHECK(report["overlapping pairs"] == 0U);
+    // Allocated while the first one was still alive and freed before the second one.
+    allocations.push_back({8U, 24U, 1U, 1U, 0U, 1U, 2U});
+    report = kitgenbench::overlap::findOverlaps(allocations, 2U);
+    CHECK(report["overlapping pairs"] == 1U);
+  }
+
+  SUBCASE("overlap while alive") {
+    std::vector<Allocation> allocations{
+        {0U, 16U, 0U, forever, 0U}, {32U, 48U, 1U, forever, 1U}, {8U, 24U, 2U, 4U, 2U}};
+    auto report = kitgenbench::overlap::findOverlaps(allocations);
+    CHECK(report["overlapping pairs"] == 1U);
+    CHECK(report["examples"].size() == 1U);
+  }
+}